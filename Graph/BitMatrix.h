@@ -0,0 +1,235 @@
+﻿#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*按位存储的方阵，每行以64位字为单位连续存储，每行的字数(跨度)会预留空间
+第r行第c列位于第r行第c/64个字的第c%64位，超出列数的位恒为0
+除了单个位的读写外，还提供了整行的与/或/差运算以及按位遍历，遍历时可以一次跳过64个0*/
+class BitMatrix
+{
+public:
+
+	using WordType = uint64_t;
+
+	static constexpr size_t WordBits = 64;
+
+	/*x中最低的1所在的位，x不能为0*/
+	static unsigned LowestBit(WordType x);
+
+	/*x中1的个数*/
+	static unsigned PopCount(WordType x);
+
+	/*dst=a&b，n为字数*/
+	static void And(WordType* dst, const WordType* a, const WordType* b, size_t n);
+
+	/*dst=a|b，n为字数*/
+	static void Or(WordType* dst, const WordType* a, const WordType* b, size_t n);
+
+	/*dst=a&~b，n为字数*/
+	static void AndNot(WordType* dst, const WordType* a, const WordType* b, size_t n);
+
+	/*统计n个字中1的个数*/
+	static size_t Count(const WordType* row, size_t n);
+
+	/*按升序遍历n个字中所有为1的位*/
+	template<class F>
+	static void ForeachBit(const WordType* row, size_t n, F func);
+
+	/*获取行列数 O(1)*/
+	size_t GetSize()const;
+
+	/*获取每行的字数 O(1)*/
+	size_t GetRowWords()const;
+
+	/*获取某一行的首地址，可以配合上面的静态函数使用 O(1)*/
+	const WordType* GetRow(size_t r)const;
+
+	/*读取一位 O(1)*/
+	bool Get(size_t r, size_t c)const;
+
+	/*写入一位 O(1)*/
+	void Set(size_t r, size_t c, bool value);
+
+	/*增加一行一列，跨度不够时按1.5倍扩展 均摊O(Size/64)*/
+	void Extend();
+
+	/*删除第i行与第i列，后面的行列前移 O(Size^2/64)*/
+	void Erase(size_t i);
+
+	/*预留size行size列的空间*/
+	void Reserve(size_t size);
+
+	/*将跨度收缩到刚好容纳所有列，并释放多余内存*/
+	void Shrink_To_Fit();
+
+	/*所有字占用的内存(byte)，包括预留的空间*/
+	unsigned long long GetMemoryUsage()const;
+
+private:
+
+	size_t m_size = 0;		//行列数
+	size_t m_rowWords = 0;	//每行的字数
+	std::vector<WordType> m_data;
+
+	/*重新排列，使每行的字数变为rowWords*/
+	void Relayout(size_t rowWords);
+};
+
+inline unsigned BitMatrix::LowestBit(WordType x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (unsigned)__builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_WIN64)
+	unsigned long i;
+	_BitScanForward64(&i, x);
+	return (unsigned)i;
+#else
+	unsigned i = 0;
+	while (!(x & 1))
+	{
+		x >>= 1;
+		++i;
+	}
+	return i;
+#endif
+}
+
+inline unsigned BitMatrix::PopCount(WordType x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (unsigned)__builtin_popcountll(x);
+#elif defined(_MSC_VER) && defined(_WIN64)
+	return (unsigned)__popcnt64(x);
+#else
+	x = x - ((x >> 1) & 0x5555555555555555ULL);
+	x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+	x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (unsigned)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline void BitMatrix::And(WordType* dst, const WordType* a, const WordType* b, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+		dst[i] = a[i] & b[i];
+}
+
+inline void BitMatrix::Or(WordType* dst, const WordType* a, const WordType* b, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+		dst[i] = a[i] | b[i];
+}
+
+inline void BitMatrix::AndNot(WordType* dst, const WordType* a, const WordType* b, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+		dst[i] = a[i] & ~b[i];
+}
+
+inline size_t BitMatrix::Count(const WordType* row, size_t n)
+{
+	size_t count = 0;
+	for (size_t i = 0; i < n; ++i)
+		count += PopCount(row[i]);
+	return count;
+}
+
+template<class F>
+inline void BitMatrix::ForeachBit(const WordType* row, size_t n, F func)
+{
+	for (size_t i = 0; i < n; ++i)
+		for (WordType word = row[i]; word != 0; word &= word - 1) //每次去掉最低的1
+			func(i * WordBits + LowestBit(word));
+}
+
+inline size_t BitMatrix::GetSize() const
+{
+	return m_size;
+}
+
+inline size_t BitMatrix::GetRowWords() const
+{
+	return m_rowWords;
+}
+
+inline const BitMatrix::WordType* BitMatrix::GetRow(size_t r) const
+{
+	return m_data.data() + r * m_rowWords;
+}
+
+inline bool BitMatrix::Get(size_t r, size_t c) const
+{
+	return (m_data[r * m_rowWords + c / WordBits] >> (c % WordBits)) & 1;
+}
+
+inline void BitMatrix::Set(size_t r, size_t c, bool value)
+{
+	WordType& word = m_data[r * m_rowWords + c / WordBits];
+	WordType mask = (WordType)1 << (c % WordBits);
+	word = value ? (word | mask) : (word & ~mask);
+}
+
+inline void BitMatrix::Extend()
+{
+	if (m_size == m_rowWords * WordBits)
+		Relayout(m_rowWords + m_rowWords / 2 + 1);
+	++m_size;
+	m_data.resize(m_size * m_rowWords, 0);
+}
+
+inline void BitMatrix::Erase(size_t i)
+{
+	//i之后的行整体上移一行
+	m_data.erase(m_data.begin() + i * m_rowWords, m_data.begin() + (i + 1) * m_rowWords);
+	--m_size;
+	//每行第i列之后的位右移一位(列号减一)，跨字时从下一个字借一位
+	size_t first = i / WordBits, words = (m_size + WordBits) / WordBits; //删除前有效的字数
+	WordType low = ((WordType)1 << (i % WordBits)) - 1;
+	for (size_t r = 0; r < m_size; ++r)
+	{
+		WordType* row = m_data.data() + r * m_rowWords;
+		row[first] = (row[first] & low) | ((row[first] >> 1) & ~low);
+		for (size_t w = first; w + 1 < words; ++w)
+		{
+			row[w] |= row[w + 1] << (WordBits - 1);
+			row[w + 1] >>= 1;
+		}
+	}
+}
+
+inline void BitMatrix::Reserve(size_t size)
+{
+	size_t rowWords = (size + WordBits - 1) / WordBits;
+	if (rowWords > m_rowWords)
+		Relayout(rowWords);
+	m_data.reserve(size * m_rowWords);
+}
+
+inline void BitMatrix::Shrink_To_Fit()
+{
+	size_t rowWords = (m_size + WordBits - 1) / WordBits;
+	if (rowWords != m_rowWords)
+		Relayout(rowWords);
+	m_data.shrink_to_fit();
+}
+
+inline unsigned long long BitMatrix::GetMemoryUsage() const
+{
+	return (unsigned long long)m_data.capacity() * sizeof(WordType) + sizeof(m_data);
+}
+
+inline void BitMatrix::Relayout(size_t rowWords)
+{
+	std::vector<WordType> data(m_size * rowWords, 0);
+	size_t copyWords = rowWords < m_rowWords ? rowWords : m_rowWords;
+	for (size_t r = 0; r < m_size; ++r)
+		for (size_t w = 0; w < copyWords; ++w)
+			data[r * rowWords + w] = m_data[r * m_rowWords + w];
+	m_data.swap(data);
+	m_rowWords = rowWords;
+}
@@ -0,0 +1,374 @@
+﻿#pragma once
+
+#include <algorithm>
+#include "GraphBase.h"
+
+/*压缩稀疏行(CSR)只读快照，可由任意GraphBase在O(VertexNum+EdgeNum)内构造
+所有邻接点存储在连续的数组中，每个顶点的邻接点按下标升序排列，遍历时缓存友好
+构造完成后图的结构不可修改，所有修改结构的操作都会抛出std::logic_error，顶点信息仍然可以通过GetVertex修改
+模板PT为邻接点下标的存储类型，只能为整形，类型越小占用的空间越小
+有向图会额外存储一份入邻接表，所以遍历入邻接点的复杂度为O(VertexInEdgeNum)*/
+template<class T, class W, class PT = size_t>
+class CSRGraph :public GraphBase<T, W>
+{
+public:
+
+	using typename GraphBase<T, W>::VertexType;
+	using typename GraphBase<T, W>::WeightType;
+	using typename GraphBase<T, W>::VertexPosType;
+	using typename GraphBase<T, W>::OnPassVertex;
+	using typename GraphBase<T, W>::OnPassEdge;
+
+	static_assert(std::is_integral<PT>::value, "类型PT必须为整型");
+	static_assert(sizeof(PT) <= sizeof(VertexPosType), "类型PT太大了，不需要这么大");
+
+	CSRGraph() = default;
+
+	/*冻结一个图，生成其快照 O(VertexNum+EdgeNum)*/
+	explicit CSRGraph(const GraphBase<T, W>& g);
+
+	/*不支持，抛出std::logic_error*/
+	virtual VertexPosType InsertVertex(const T& v) override;
+
+	/*不支持，抛出std::logic_error*/
+	virtual void InsertEdge(VertexPosType from, VertexPosType to, const W& weight) override;
+
+	/*查找从from到to是否存在边 O(log(VertexEdgeNum))*/
+	virtual bool ExistEdge(VertexPosType from, VertexPosType to)const override;
+
+	/*获取从from到to的权重 O(log(VertexEdgeNum))*/
+	virtual W GetWeight(VertexPosType from, VertexPosType to)const override;
+
+	/*不支持，抛出std::logic_error*/
+	virtual void SetWeight(VertexPosType from, VertexPosType to, const W& weight)override;
+
+	/*不支持，抛出std::logic_error*/
+	virtual void RemoveVertex(VertexPosType v) override;
+
+	/*不支持，抛出std::logic_error*/
+	virtual void RemoveEdge(VertexPosType from, VertexPosType to) override;
+
+	/*不支持，抛出std::logic_error*/
+	virtual void LazyRemoveVertex(VertexPosType v) override;
+
+	/*不支持，抛出std::logic_error*/
+	virtual std::vector<VertexPosType> Compact() override;
+
+	/*遍历出邻接点 O(VertexEdgeNum)*/
+	virtual void ForeachOutNeighbor(VertexPosType v, OnPassVertex func)const override;
+
+	/*遍历入邻接点 O(VertexInEdgeNum)*/
+	virtual void ForeachInNeighbor(VertexPosType v, OnPassVertex func)const override;
+
+	/*遍历出邻接点 O(VertexEdgeNum)*/
+	virtual void ForeachOutNeighbor(VertexPosType v, OnPassEdge func)const override;
+
+	/*遍历入邻接点 O(VertexInEdgeNum)*/
+	virtual void ForeachInNeighbor(VertexPosType v, OnPassEdge func)const override;
+
+	/*遍历所有边，无向图中每条边只遍历一次 O(EdgeNum)*/
+	virtual void ForeachEdge(OnPassEdge func)const override;
+
+	/*获取完整邻接矩阵，二维的邻接矩阵会以行为单位，存储在一维线性表中 O(VertexNum^2)*/
+	virtual std::vector<W> GetAdjacencyMatrix()const override;
+
+	/*该数值为主要占用的准确数值*/
+	virtual unsigned long long GetMemoryUsage()const override;
+
+	/*获取出度 O(1)*/
+	size_t GetOutDegree(VertexPosType v)const;
+
+	/*获取入度 O(1)*/
+	size_t GetInDegree(VertexPosType v)const;
+
+	/*与源图相同*/
+	virtual constexpr bool IsDirected()const override;
+
+	/*与源图相同*/
+	virtual constexpr bool IsWeighted()const override;
+
+	virtual constexpr bool IsMatrix()const override;
+
+private:
+
+	bool m_directed = true;
+	bool m_weighted = false;
+
+	std::vector<size_t> m_outOffset;	//出邻接表每行的起始位置，共VertexNum+1个
+	std::vector<PT> m_outTarget;		//出邻接点
+	std::vector<W> m_outWeight;			//出边权重，无权图不存储
+	std::vector<size_t> m_inOffset;		//入邻接表，只在有向图中存储
+	std::vector<PT> m_inSource;
+	std::vector<W> m_inWeight;
+
+	/*将邻接表转置，转置后每行的邻接点是升序的*/
+	void Transpose(const std::vector<size_t>& offset, const std::vector<PT>& adja, const std::vector<W>& weight,
+		std::vector<size_t>& tOffset, std::vector<PT>& tAdja, std::vector<W>& tWeight)const;
+
+	/*获取边的权重，无权图恒为1*/
+	W GetEdgeWeight(const std::vector<W>& weight, size_t pos)const;
+
+	/*查找出边所在位置，没有则返回NPOS*/
+	size_t FindOutEdge(VertexPosType from, VertexPosType to)const;
+
+	/*抛出只读异常*/
+	[[noreturn]] void ThrowReadOnly()const;
+};
+
+template<class T, class W, class PT>
+inline CSRGraph<T, W, PT>::CSRGraph(const GraphBase<T, W>& g) :
+	m_directed(g.IsDirected()), m_weighted(g.IsWeighted())
+{
+	size_t vertexNum = g.GetVertexNum();
+	this->m_vertexData.reserve(vertexNum);
+	for (VertexPosType i = 0; i < vertexNum; ++i)
+		this->m_vertexData.push_back(g.GetVertex(i));
+	if (g.GetRemovedVertexNum() != 0) //保留被标记删除的顶点，下标与原图一致
+	{
+		this->m_removed.resize(vertexNum, false);
+		for (VertexPosType i = 0; i < vertexNum; ++i)
+			if (g.IsVertexRemoved(i))
+			{
+				this->m_removed[i] = true;
+				this->m_freeSlots.push_back(i);
+			}
+	}
+	this->m_edgeNum = g.GetEdgeNum();
+
+	/*先按起点分桶(桶内无序)，再转置一次得到按终点分桶且桶内有序的入邻接表，
+	再转置一次就得到桶内有序的出邻接表，无向图是对称的，转置一次就已经是出邻接表了*/
+	std::vector<size_t> offset(vertexNum + 1, 0);
+	g.ForeachEdge([&](auto from, auto to, auto /*w*/)
+		{
+			++offset[from + 1];
+			if (!m_directed && from != to)
+				++offset[to + 1];
+		});
+	for (VertexPosType i = 0; i < vertexNum; ++i)
+		offset[i + 1] += offset[i];
+
+	std::vector<size_t> cursor(offset.begin(), offset.end() - 1);
+	std::vector<PT> adja(offset.back());
+	std::vector<W> weight(m_weighted ? offset.back() : 0);
+	g.ForeachEdge([&](auto from, auto to, auto w)
+		{
+			size_t pos = cursor[from]++;
+			adja[pos] = (PT)to;
+			if (m_weighted)
+				weight[pos] = w;
+			if (!m_directed && from != to)
+			{
+				pos = cursor[to]++;
+				adja[pos] = (PT)from;
+				if (m_weighted)
+					weight[pos] = w;
+			}
+		});
+
+	if (m_directed)
+	{
+		Transpose(offset, adja, weight, m_inOffset, m_inSource, m_inWeight);
+		Transpose(m_inOffset, m_inSource, m_inWeight, m_outOffset, m_outTarget, m_outWeight);
+	}
+	else
+		Transpose(offset, adja, weight, m_outOffset, m_outTarget, m_outWeight);
+}
+
+template<class T, class W, class PT>
+inline typename CSRGraph<T, W, PT>::VertexPosType CSRGraph<T, W, PT>::InsertVertex(const T& /*v*/)
+{
+	ThrowReadOnly();
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::InsertEdge(VertexPosType /*from*/, VertexPosType /*to*/, const W& /*weight*/)
+{
+	ThrowReadOnly();
+}
+
+template<class T, class W, class PT>
+inline bool CSRGraph<T, W, PT>::ExistEdge(VertexPosType from, VertexPosType to) const
+{
+	return FindOutEdge(from, to) != this->NPOS;
+}
+
+template<class T, class W, class PT>
+inline W CSRGraph<T, W, PT>::GetWeight(VertexPosType from, VertexPosType to) const
+{
+	size_t pos = FindOutEdge(from, to);
+	return (pos == this->NPOS ? (W)0 : GetEdgeWeight(m_outWeight, pos));
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::SetWeight(VertexPosType /*from*/, VertexPosType /*to*/, const W& /*weight*/)
+{
+	ThrowReadOnly();
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::RemoveVertex(VertexPosType /*v*/)
+{
+	ThrowReadOnly();
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::RemoveEdge(VertexPosType /*from*/, VertexPosType /*to*/)
+{
+	ThrowReadOnly();
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::LazyRemoveVertex(VertexPosType /*v*/)
+{
+	ThrowReadOnly();
+}
+
+template<class T, class W, class PT>
+inline std::vector<typename CSRGraph<T, W, PT>::VertexPosType> CSRGraph<T, W, PT>::Compact()
+{
+	ThrowReadOnly();
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::ForeachOutNeighbor(VertexPosType v, OnPassVertex func) const
+{
+	for (size_t i = m_outOffset[v]; i < m_outOffset[v + 1]; ++i)
+		func((VertexPosType)m_outTarget[i]);
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::ForeachInNeighbor(VertexPosType v, OnPassVertex func) const
+{
+	if (!m_directed) //对于无向图，出入相同
+	{
+		ForeachOutNeighbor(v, func);
+		return;
+	}
+	for (size_t i = m_inOffset[v]; i < m_inOffset[v + 1]; ++i)
+		func((VertexPosType)m_inSource[i]);
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::ForeachOutNeighbor(VertexPosType v, OnPassEdge func) const
+{
+	for (size_t i = m_outOffset[v]; i < m_outOffset[v + 1]; ++i)
+		func(v, (VertexPosType)m_outTarget[i], GetEdgeWeight(m_outWeight, i));
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
+{
+	if (!m_directed)
+	{
+		for (size_t i = m_outOffset[v]; i < m_outOffset[v + 1]; ++i)
+			func((VertexPosType)m_outTarget[i], v, GetEdgeWeight(m_outWeight, i));
+		return;
+	}
+	for (size_t i = m_inOffset[v]; i < m_inOffset[v + 1]; ++i)
+		func((VertexPosType)m_inSource[i], v, GetEdgeWeight(m_inWeight, i));
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::ForeachEdge(OnPassEdge func) const
+{
+	for (VertexPosType from = 0; from < this->GetVertexNum(); ++from)
+		for (size_t i = m_outOffset[from]; i < m_outOffset[from + 1]; ++i)
+			if (m_directed || from <= (VertexPosType)m_outTarget[i])
+				func(from, (VertexPosType)m_outTarget[i], GetEdgeWeight(m_outWeight, i));
+}
+
+template<class T, class W, class PT>
+inline std::vector<W> CSRGraph<T, W, PT>::GetAdjacencyMatrix() const
+{
+	std::vector<W> adjaMetrix(this->GetVertexNum() * this->GetVertexNum(), (W)0);
+	for (VertexPosType from = 0; from < this->GetVertexNum(); ++from)
+		for (size_t i = m_outOffset[from]; i < m_outOffset[from + 1]; ++i)
+			adjaMetrix[from * this->GetVertexNum() + m_outTarget[i]] = GetEdgeWeight(m_outWeight, i);
+	return adjaMetrix;
+}
+
+template<class T, class W, class PT>
+inline unsigned long long CSRGraph<T, W, PT>::GetMemoryUsage() const
+{
+	return (unsigned long long)(m_outOffset.size() + m_inOffset.size()) * sizeof(size_t)
+		+ (unsigned long long)(m_outTarget.size() + m_inSource.size()) * sizeof(PT)
+		+ (unsigned long long)(m_outWeight.size() + m_inWeight.size()) * sizeof(W)
+		+ sizeof(m_outOffset) * 2 + sizeof(m_outTarget) * 2 + sizeof(m_outWeight) * 2;
+}
+
+template<class T, class W, class PT>
+inline size_t CSRGraph<T, W, PT>::GetOutDegree(VertexPosType v) const
+{
+	return m_outOffset[v + 1] - m_outOffset[v];
+}
+
+template<class T, class W, class PT>
+inline size_t CSRGraph<T, W, PT>::GetInDegree(VertexPosType v) const
+{
+	return m_directed ? m_inOffset[v + 1] - m_inOffset[v] : GetOutDegree(v);
+}
+
+template<class T, class W, class PT>
+inline constexpr bool CSRGraph<T, W, PT>::IsDirected() const
+{
+	return m_directed;
+}
+
+template<class T, class W, class PT>
+inline constexpr bool CSRGraph<T, W, PT>::IsWeighted() const
+{
+	return m_weighted;
+}
+
+template<class T, class W, class PT>
+inline constexpr bool CSRGraph<T, W, PT>::IsMatrix() const
+{
+	return false;
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::Transpose(const std::vector<size_t>& offset, const std::vector<PT>& adja, const std::vector<W>& weight,
+	std::vector<size_t>& tOffset, std::vector<PT>& tAdja, std::vector<W>& tWeight) const
+{
+	size_t vertexNum = offset.size() - 1;
+	tOffset.assign(vertexNum + 1, 0);
+	for (auto i : adja)
+		++tOffset[(size_t)i + 1];
+	for (size_t i = 0; i < vertexNum; ++i)
+		tOffset[i + 1] += tOffset[i];
+
+	std::vector<size_t> cursor(tOffset.begin(), tOffset.end() - 1);
+	tAdja.resize(adja.size());
+	tWeight.resize(weight.size());
+	for (size_t from = 0; from < vertexNum; ++from) //按起点升序放入，所以转置后每一行都是有序的
+		for (size_t i = offset[from]; i < offset[from + 1]; ++i)
+		{
+			size_t pos = cursor[adja[i]]++;
+			tAdja[pos] = (PT)from;
+			if (!weight.empty())
+				tWeight[pos] = weight[i];
+		}
+}
+
+template<class T, class W, class PT>
+inline W CSRGraph<T, W, PT>::GetEdgeWeight(const std::vector<W>& weight, size_t pos) const
+{
+	return m_weighted ? weight[pos] : (W)1;
+}
+
+template<class T, class W, class PT>
+inline size_t CSRGraph<T, W, PT>::FindOutEdge(VertexPosType from, VertexPosType to) const
+{
+	auto begin = m_outTarget.begin() + m_outOffset[from];
+	auto end = m_outTarget.begin() + m_outOffset[from + 1];
+	auto it = std::lower_bound(begin, end, (PT)to);
+	if (it == end || (VertexPosType)*it != to)
+		return this->NPOS;
+	return (size_t)(it - m_outTarget.begin());
+}
+
+template<class T, class W, class PT>
+inline void CSRGraph<T, W, PT>::ThrowReadOnly() const
+{
+	throw std::logic_error("CSRGraph为只读快照，不支持修改图的结构");
+}
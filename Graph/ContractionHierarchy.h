@@ -0,0 +1,647 @@
+﻿#pragma once
+
+#include <type_traits>
+#include <functional>
+#include <vector>
+#include <queue>
+#include <utility>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <cstdint>
+#include "GraphBase.h"
+
+/*收缩层次(Contraction Hierarchy)，对很少修改的图预处理一次，之后的点对点查询只需要访问很少的顶点
+预处理：按优先级(边差+已收缩的邻接点数+层数)从小到大依次收缩顶点，收缩v时，对每对邻接点u->v->w，
+	如果不经过v找不到不长于u->v->w的路径(见证路径)，就添加捷径u->w，捷径记录中间顶点v，用来展开路径
+查询：从src沿等级升高的出边、从target沿等级升高的入边做双向dijkstra，最短路径一定经过两边都能到达的等级最高的顶点
+预处理后与原图无关，原图修改后需要重新Build，可以用Save/Load保存到文件中
+WT是权重累加和类型，权重不能为负数*/
+template<class WT>
+class ContractionHierarchy
+{
+public:
+
+	static_assert(std::is_arithmetic<WT>::value, "类型WT必须为算数类型");
+
+	static constexpr auto NullValue = static_cast<WT>(-1);
+
+	/*见证路径搜索最多收录的顶点数，越大捷径越少，但预处理越慢*/
+	static constexpr size_t WitnessSettleLimit = 500;
+
+	/*从任意图构造收缩层次，无权图的每条边视为1，重边取最小的权重*/
+	template<class T, class W>
+	void Build(const GraphBase<T, W>& g);
+
+	/*查询src到target的最短路径，结果通过GetDistance和ForeachPath获取，查询之间复用工作空间，不需要O(VertexNum)的初始化*/
+	void Execute(size_t src, size_t target);
+
+	/*清除*/
+	void Clear();
+
+	/*是否为空 O(1)*/
+	bool IsEmpty()const;
+
+	/*顶点数量 O(1)*/
+	size_t GetVertexNum()const;
+
+	/*捷径数量 O(1)*/
+	size_t GetShortcutNum()const;
+
+	/*顶点的等级，即收缩的顺序 O(1)*/
+	size_t GetRank(size_t v)const;
+
+	/*上一次查询的源点 O(1)*/
+	size_t GetSrc()const;
+
+	/*上一次查询的终点 O(1)*/
+	size_t GetTarget()const;
+
+	/*上一次查询的最短距离，不通时为NullValue O(1)*/
+	WT GetDistance()const;
+
+	/*按顺序遍历上一次查询的最短路径，捷径会被展开为原图中的边 O(Path)*/
+	void ForeachPath(std::function<void(size_t)> func)const;
+
+	/*以二进制格式写入os*/
+	void Save(std::ostream& os)const;
+
+	/*从is中读取Save写入的数据，格式不对时抛出std::runtime_error*/
+	void Load(std::istream& is);
+
+private:
+
+	/*边，middle为捷径的中间顶点，原图中的边为m_size*/
+	struct _Edge
+	{
+		size_t vertex;
+		WT weight;
+		size_t middle;
+	};
+
+	/*查询时每个顶点的信息，stamp不等于m_stamp时视为未访问*/
+	struct _SearchInfo
+	{
+		WT dist;
+		size_t prevVertex;	//正向搜索中为前驱，反向搜索中为后继
+		size_t middle;		//到prevVertex的边的中间顶点
+		size_t stamp;
+		bool settled;
+	};
+
+	typedef std::pair<WT, size_t> _HeapNode;
+	typedef std::priority_queue<_HeapNode, std::vector<_HeapNode>, std::greater<_HeapNode>> _Heap;
+
+	size_t m_size = 0;
+	size_t m_shortcutNum = 0;
+	std::vector<size_t> m_rank;
+	std::vector<size_t> m_offset[2];	//CSR的行偏移，0为向上的出边，1为向上的入边
+	std::vector<_Edge> m_edges[2];		//m_edges[0]中为v->x，m_edges[1]中为x->v，x的等级都比v高
+
+	size_t m_src = 0;
+	size_t m_target = 0;
+	size_t m_meet = 0;
+	WT m_dist = NullValue;
+	size_t m_stamp = 0;
+	std::vector<_SearchInfo> m_info[2];
+	std::vector<_HeapNode> m_heap[2];	//用std::push_heap维护的最小堆，查询之间保留容量
+
+	/*预处理时的动态邻接表，out[v]为v的出边，in[v]为v的入边(vertex为起点)，只保留未收缩的顶点之间的边*/
+	struct _BuildState
+	{
+		std::vector<std::vector<_Edge>> out;
+		std::vector<std::vector<_Edge>> in;
+		std::vector<bool> contracted;
+		std::vector<size_t> deleted;		//已经收缩的邻接点数
+		std::vector<size_t> level;			//层数，比所有已收缩的邻接点的层数大1
+		std::vector<WT> witnessDist;
+		std::vector<size_t> witnessStamp;
+		size_t stamp = 0;
+	};
+
+	/*添加或更新边，已有的边权重更小时不修改 O(Degree)*/
+	static void AddEdge(std::vector<_Edge>& list, size_t vertex, WT weight, size_t middle);
+
+	/*收缩v需要的捷径数量，dryRun为false时真正添加捷径 O(Degree^2*见证搜索)*/
+	size_t Contract(_BuildState& s, size_t v, bool dryRun);
+
+	/*从u出发不经过v的有限dijkstra，距离超过limit或者收录顶点数达到上限时停止，结果在s.witnessDist中*/
+	void WitnessSearch(_BuildState& s, size_t u, size_t v, WT limit);
+
+	/*v的优先级，越小越先收缩*/
+	long long GetPriority(_BuildState& s, size_t v);
+
+	/*按照m_edges中的边展开a->b，middle为边的中间顶点，不输出a*/
+	void Unpack(size_t a, size_t b, size_t middle, std::vector<size_t>& path)const;
+
+	/*在v向上的边中查找端点为x的边 O(Degree)*/
+	const _Edge& FindEdge(size_t dir, size_t v, size_t x)const;
+
+	/*获取第dir个搜索中的顶点信息，本次查询没有访问过时先初始化*/
+	_SearchInfo& GetInfo(size_t dir, size_t v);
+};
+
+/*权重为非负整数的收缩层次*/
+typedef ContractionHierarchy<unsigned long long> IntegerContractionHierarchy;
+/*权重为非负小数的收缩层次*/
+typedef ContractionHierarchy<double> DecimalContractionHierarchy;
+
+template<class WT>
+template<class T, class W>
+inline void ContractionHierarchy<WT>::Build(const GraphBase<T, W>& g)
+{
+	Clear();
+	size_t num = g.GetVertexNum();
+	m_size = num;
+	if (num == 0)
+		return;
+
+	_BuildState s;
+	s.out.resize(num);
+	s.in.resize(num);
+	s.contracted.resize(num, false);
+	s.deleted.resize(num, 0);
+	s.level.resize(num, 0);
+	s.witnessDist.resize(num);
+	s.witnessStamp.resize(num, 0);
+	g.ForeachEdge([&](auto from, auto to, auto w)
+		{
+			if ((size_t)from == (size_t)to) //自环不会出现在最短路径上
+				return;
+			WT weight = g.IsWeighted() ? (WT)w : (WT)1;
+			AddEdge(s.out[from], to, weight, num);
+			AddEdge(s.in[to], from, weight, num);
+			if (!g.IsDirected())
+			{
+				AddEdge(s.out[to], from, weight, num);
+				AddEdge(s.in[from], to, weight, num);
+			}
+		});
+
+	typedef std::pair<long long, size_t> _Priority;
+	std::priority_queue<_Priority, std::vector<_Priority>, std::greater<_Priority>> pq;
+	std::vector<long long> priority(num); //当前的优先级，与堆中不同的节点已经过期
+	for (size_t v = 0; v < num; ++v)
+		pq.emplace(priority[v] = GetPriority(s, v), v);
+	std::vector<size_t> neighbors;
+
+	m_rank.resize(num);
+	std::vector<std::vector<_Edge>> up[2];
+	up[0].resize(num);
+	up[1].resize(num);
+	size_t rank = 0;
+	while (!pq.empty())
+	{
+		size_t v = pq.top().second;
+		long long oldPriority = pq.top().first;
+		pq.pop();
+		if (s.contracted[v] || oldPriority != priority[v]) //过期的节点
+			continue;
+		//惰性更新：弹出时重新计算，比下一个大就放回去
+		priority[v] = GetPriority(s, v);
+		if (!pq.empty() && priority[v] > pq.top().first)
+		{
+			pq.emplace(priority[v], v);
+			continue;
+		}
+
+		Contract(s, v, false);
+		m_rank[v] = rank++;
+		s.contracted[v] = true;
+		//剩下的边的另一端都比v晚收缩，即等级更高
+		for (auto& e : s.out[v])
+		{
+			up[0][v].push_back(e);
+			++s.deleted[e.vertex];
+			for (size_t i = 0; i < s.in[e.vertex].size(); ++i)
+				if (s.in[e.vertex][i].vertex == v)
+				{
+					s.in[e.vertex][i] = s.in[e.vertex].back();
+					s.in[e.vertex].pop_back();
+					break;
+				}
+		}
+		for (auto& e : s.in[v])
+		{
+			up[1][v].push_back(e);
+			++s.deleted[e.vertex];
+			for (size_t i = 0; i < s.out[e.vertex].size(); ++i)
+				if (s.out[e.vertex][i].vertex == v)
+				{
+					s.out[e.vertex][i] = s.out[e.vertex].back();
+					s.out[e.vertex].pop_back();
+					break;
+				}
+		}
+		//邻接点的优先级变化最大，立即更新
+		neighbors.clear();
+		for (auto& e : s.out[v])
+			neighbors.push_back(e.vertex);
+		for (auto& e : s.in[v])
+			neighbors.push_back(e.vertex);
+		std::sort(neighbors.begin(), neighbors.end());
+		neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+		std::vector<_Edge>().swap(s.out[v]);
+		std::vector<_Edge>().swap(s.in[v]);
+		for (auto x : neighbors)
+		{
+			s.level[x] = std::max(s.level[x], s.level[v] + 1);
+			pq.emplace(priority[x] = GetPriority(s, x), x);
+		}
+	}
+
+	for (size_t dir = 0; dir < 2; ++dir) //转为CSR，查询时连续访问
+	{
+		m_offset[dir].resize(num + 1);
+		m_offset[dir][0] = 0;
+		for (size_t v = 0; v < num; ++v)
+			m_offset[dir][v + 1] = m_offset[dir][v] + up[dir][v].size();
+		m_edges[dir].reserve(m_offset[dir][num]);
+		for (size_t v = 0; v < num; ++v)
+		{
+			m_edges[dir].insert(m_edges[dir].end(), up[dir][v].begin(), up[dir][v].end());
+			std::vector<_Edge>().swap(up[dir][v]);
+		}
+		for (auto& e : m_edges[dir])
+			if (e.middle != num)
+				++m_shortcutNum;
+	}
+}
+
+template<class WT>
+inline void ContractionHierarchy<WT>::AddEdge(std::vector<_Edge>& list, size_t vertex, WT weight, size_t middle)
+{
+	for (auto& e : list)
+		if (e.vertex == vertex)
+		{
+			if (weight < e.weight)
+			{
+				e.weight = weight;
+				e.middle = middle;
+			}
+			return;
+		}
+	list.push_back({ vertex, weight, middle });
+}
+
+template<class WT>
+inline size_t ContractionHierarchy<WT>::Contract(_BuildState& s, size_t v, bool dryRun)
+{
+	size_t shortcutNum = 0;
+	std::vector<_Edge> shortcuts; //先收集再添加，避免在遍历时修改s.out
+	for (auto& in : s.in[v])
+	{
+		size_t u = in.vertex;
+		WT limit = (WT)0;
+		for (auto& out : s.out[v])
+			if (out.vertex != u && in.weight + out.weight > limit)
+				limit = in.weight + out.weight;
+		if (limit == (WT)0) //v只有u这一个邻接点
+			continue;
+		WitnessSearch(s, u, v, limit);
+		for (auto& out : s.out[v])
+		{
+			size_t w = out.vertex;
+			if (w == u)
+				continue;
+			WT dist = in.weight + out.weight;
+			if (s.witnessStamp[w] == s.stamp && s.witnessDist[w] <= dist) //有见证路径
+				continue;
+			++shortcutNum;
+			if (!dryRun)
+				shortcuts.push_back({ u, dist, w });
+		}
+	}
+	for (auto& e : shortcuts) //这里vertex为起点，middle暂时存放终点
+	{
+		AddEdge(s.out[e.vertex], e.middle, e.weight, v);
+		AddEdge(s.in[e.middle], e.vertex, e.weight, v);
+	}
+	return shortcutNum;
+}
+
+template<class WT>
+inline void ContractionHierarchy<WT>::WitnessSearch(_BuildState& s, size_t u, size_t v, WT limit)
+{
+	_Heap pq;
+	size_t stamp = ++s.stamp;
+	size_t settled = 0;
+	s.witnessStamp[u] = stamp;
+	s.witnessDist[u] = (WT)0;
+	pq.emplace((WT)0, u);
+	while (!pq.empty() && settled < WitnessSettleLimit)
+	{
+		_HeapNode top = pq.top();
+		pq.pop();
+		if (top.first > s.witnessDist[top.second]) //过期的节点
+			continue;
+		if (top.first > limit)
+			break;
+		++settled;
+		for (auto& e : s.out[top.second])
+		{
+			if (e.vertex == v)
+				continue;
+			WT dist = top.first + e.weight;
+			if (s.witnessStamp[e.vertex] != stamp || dist < s.witnessDist[e.vertex])
+			{
+				s.witnessStamp[e.vertex] = stamp;
+				s.witnessDist[e.vertex] = dist;
+				pq.emplace(dist, e.vertex);
+			}
+		}
+	}
+}
+
+template<class WT>
+inline long long ContractionHierarchy<WT>::GetPriority(_BuildState& s, size_t v)
+{
+	//边差：收缩后增加的边数，收缩后图越稀疏越好，权重最大
+	//加上已收缩的邻接点数和层数，让收缩的顶点在图中分布均匀，层次不会太深
+	long long shortcuts = (long long)Contract(s, v, true);
+	long long removed = (long long)(s.in[v].size() + s.out[v].size());
+	return 4 * (shortcuts - removed) + (long long)s.deleted[v] + (long long)s.level[v];
+}
+
+template<class WT>
+inline void ContractionHierarchy<WT>::Execute(size_t src, size_t target)
+{
+	m_src = src;
+	m_target = target;
+	m_meet = m_size;
+	m_dist = NullValue;
+	if (src >= m_size || target >= m_size)
+		return;
+	if (++m_stamp == 0) //时间戳用完了一轮，全部重置
+	{
+		for (auto& info : m_info)
+			for (auto& i : info)
+				i.stamp = 0;
+		m_stamp = 1;
+	}
+	std::greater<_HeapNode> cmp;
+	size_t start[2] = { src, target };
+	for (size_t dir = 0; dir < 2; ++dir)
+	{
+		m_info[dir].resize(m_size);
+		m_heap[dir].clear();
+		GetInfo(dir, start[dir]).dist = (WT)0;
+		m_heap[dir].emplace_back((WT)0, start[dir]);
+	}
+
+	//两边交替扩展，某一边堆顶的距离不小于当前最优解时那一边就可以停止了
+	bool found = false;
+	WT best = (WT)0;
+	size_t dir = 0;
+	while (!m_heap[0].empty() || !m_heap[1].empty())
+	{
+		if (m_heap[dir].empty())
+			dir ^= 1;
+		std::pop_heap(m_heap[dir].begin(), m_heap[dir].end(), cmp);
+		_HeapNode top = m_heap[dir].back();
+		m_heap[dir].pop_back();
+		if (found && top.first >= best)
+		{
+			m_heap[dir].clear();
+			dir ^= 1;
+			continue;
+		}
+		_SearchInfo& info = GetInfo(dir, top.second);
+		if (info.settled || top.first > info.dist)
+		{
+			dir ^= 1;
+			continue;
+		}
+		info.settled = true;
+		//stall-on-demand：如果能从等级更高的已访问顶点走下来得到更短的距离，这个顶点不在最短路径上，不用扩展
+		bool stalled = false;
+		for (size_t i = m_offset[dir ^ 1][top.second]; i < m_offset[dir ^ 1][top.second + 1] && !stalled; ++i)
+		{
+			const _Edge& e = m_edges[dir ^ 1][i];
+			const _SearchInfo& prev = m_info[dir][e.vertex];
+			stalled = prev.stamp == m_stamp && prev.dist != NullValue && prev.dist + e.weight < top.first;
+		}
+		if (stalled)
+		{
+			dir ^= 1;
+			continue;
+		}
+		_SearchInfo& other = GetInfo(dir ^ 1, top.second);
+		if (other.dist != NullValue && (!found || top.first + other.dist < best))
+		{
+			found = true;
+			best = top.first + other.dist;
+			m_meet = top.second;
+		}
+		for (size_t i = m_offset[dir][top.second]; i < m_offset[dir][top.second + 1]; ++i)
+		{
+			const _Edge& e = m_edges[dir][i];
+			WT dist = top.first + e.weight;
+			_SearchInfo& next = GetInfo(dir, e.vertex);
+			if (!next.settled && (next.dist == NullValue || dist < next.dist))
+			{
+				next.dist = dist;
+				next.prevVertex = top.second;
+				next.middle = e.middle;
+				m_heap[dir].emplace_back(dist, e.vertex);
+				std::push_heap(m_heap[dir].begin(), m_heap[dir].end(), cmp);
+			}
+		}
+		dir ^= 1;
+	}
+	if (found)
+		m_dist = best;
+}
+
+template<class WT>
+inline typename ContractionHierarchy<WT>::_SearchInfo& ContractionHierarchy<WT>::GetInfo(size_t dir, size_t v)
+{
+	_SearchInfo& info = m_info[dir][v];
+	if (info.stamp != m_stamp)
+		info = { NullValue, m_size, m_size, m_stamp, false };
+	return info;
+}
+
+template<class WT>
+inline const typename ContractionHierarchy<WT>::_Edge& ContractionHierarchy<WT>::FindEdge(size_t dir, size_t v, size_t x) const
+{
+	size_t i = m_offset[dir][v];
+	while (m_edges[dir][i].vertex != x)
+		++i;
+	return m_edges[dir][i];
+}
+
+template<class WT>
+inline void ContractionHierarchy<WT>::Unpack(size_t a, size_t b, size_t middle, std::vector<size_t>& path) const
+{
+	if (middle == m_size)
+	{
+		path.push_back(b);
+		return;
+	}
+	//middle的等级比a和b都低，a->middle存在middle的向上入边中，middle->b存在middle的向上出边中
+	Unpack(a, middle, FindEdge(1, middle, a).middle, path);
+	Unpack(middle, b, FindEdge(0, middle, b).middle, path);
+}
+
+template<class WT>
+inline void ContractionHierarchy<WT>::ForeachPath(std::function<void(size_t)> func) const
+{
+	if (m_dist == NullValue)
+		return;
+	//正向搜索树中src->meet的各条边，逆序
+	std::vector<std::pair<size_t, size_t>> forward; //(前驱, 中间顶点)，对应边 前驱->顶点
+	for (size_t v = m_meet; v != m_src; v = m_info[0][v].prevVertex)
+		forward.emplace_back(m_info[0][v].prevVertex, m_info[0][v].middle);
+	std::vector<size_t> path{ m_src };
+	size_t cur = m_src;
+	for (auto i = forward.rbegin(); i != forward.rend(); ++i)
+	{
+		size_t next = (i + 1 == forward.rend()) ? m_meet : (i + 1)->first;
+		Unpack(cur, next, i->second, path);
+		cur = next;
+	}
+	//反向搜索树中meet->target的各条边，顺序
+	for (size_t v = m_meet; v != m_target; v = m_info[1][v].prevVertex)
+		Unpack(v, m_info[1][v].prevVertex, m_info[1][v].middle, path);
+	for (auto v : path)
+		func(v);
+}
+
+template<class WT>
+inline void ContractionHierarchy<WT>::Clear()
+{
+	m_size = 0;
+	m_shortcutNum = 0;
+	m_src = m_target = m_meet = 0;
+	m_dist = NullValue;
+	m_stamp = 0;
+	std::vector<size_t>().swap(m_rank);
+	for (size_t dir = 0; dir < 2; ++dir)
+	{
+		std::vector<size_t>().swap(m_offset[dir]);
+		std::vector<_Edge>().swap(m_edges[dir]);
+		std::vector<_SearchInfo>().swap(m_info[dir]);
+		std::vector<_HeapNode>().swap(m_heap[dir]);
+	}
+}
+
+template<class WT>
+inline bool ContractionHierarchy<WT>::IsEmpty() const
+{
+	return m_size == 0;
+}
+
+template<class WT>
+inline size_t ContractionHierarchy<WT>::GetVertexNum() const
+{
+	return m_size;
+}
+
+template<class WT>
+inline size_t ContractionHierarchy<WT>::GetShortcutNum() const
+{
+	return m_shortcutNum;
+}
+
+template<class WT>
+inline size_t ContractionHierarchy<WT>::GetRank(size_t v) const
+{
+	return m_rank[v];
+}
+
+template<class WT>
+inline size_t ContractionHierarchy<WT>::GetSrc() const
+{
+	return m_src;
+}
+
+template<class WT>
+inline size_t ContractionHierarchy<WT>::GetTarget() const
+{
+	return m_target;
+}
+
+template<class WT>
+inline WT ContractionHierarchy<WT>::GetDistance() const
+{
+	return m_dist;
+}
+
+template<class WT>
+inline void ContractionHierarchy<WT>::Save(std::ostream& os) const
+{
+	//格式：标记 sizeof(WT) 顶点数 捷径数 等级 两个方向的边数、偏移、边，整数统一按uint64_t写入
+	auto write = [&](uint64_t x) { os.write(reinterpret_cast<const char*>(&x), sizeof(x)); };
+	write(0x4843ULL); //"CH"
+	write(sizeof(WT));
+	write(m_size);
+	write(m_shortcutNum);
+	for (auto r : m_rank)
+		write(r);
+	for (size_t dir = 0; dir < 2; ++dir)
+	{
+		write(m_edges[dir].size());
+		for (auto o : m_offset[dir])
+			write(o);
+		for (auto& e : m_edges[dir])
+		{
+			write(e.vertex);
+			os.write(reinterpret_cast<const char*>(&e.weight), sizeof(WT));
+			write(e.middle);
+		}
+	}
+}
+
+template<class WT>
+inline void ContractionHierarchy<WT>::Load(std::istream& is)
+{
+	Clear();
+	auto read = [&]()
+	{
+		uint64_t x;
+		if (!is.read(reinterpret_cast<char*>(&x), sizeof(x)))
+			throw std::runtime_error("收缩层次数据不完整");
+		return x;
+	};
+	if (read() != 0x4843ULL || read() != sizeof(WT))
+		throw std::runtime_error("不是当前类型的收缩层次数据");
+	size_t num = (size_t)read();
+	size_t shortcutNum = (size_t)read();
+	std::vector<size_t> rank(num);
+	for (auto& r : rank)
+		r = (size_t)read();
+	std::vector<size_t> offset[2];
+	std::vector<_Edge> edges[2];
+	for (size_t dir = 0; dir < 2; ++dir)
+	{
+		size_t edgeNum = (size_t)read();
+		offset[dir].resize(num + 1);
+		for (auto& o : offset[dir])
+			o = (size_t)read();
+		if (offset[dir][0] != 0 || offset[dir][num] != edgeNum)
+			throw std::runtime_error("收缩层次数据已损坏");
+		for (size_t i = 0; i < num; ++i) //每个顶点的边必须是[0, edgeNum)中的一段
+			if (offset[dir][i] > offset[dir][i + 1])
+				throw std::runtime_error("收缩层次数据已损坏");
+		edges[dir].resize(edgeNum);
+		for (auto& e : edges[dir])
+		{
+			e.vertex = (size_t)read();
+			if (!is.read(reinterpret_cast<char*>(&e.weight), sizeof(WT)))
+				throw std::runtime_error("收缩层次数据不完整");
+			e.middle = (size_t)read();
+			if (e.vertex >= num || e.middle > num)
+				throw std::runtime_error("收缩层次数据已损坏");
+		}
+	}
+	m_size = num;
+	m_shortcutNum = shortcutNum;
+	m_rank.swap(rank);
+	for (size_t dir = 0; dir < 2; ++dir)
+	{
+		m_offset[dir].swap(offset[dir]);
+		m_edges[dir].swap(edges[dir]);
+	}
+}
@@ -0,0 +1,258 @@
+﻿#pragma once
+
+#include <vector>
+#include <atomic>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+
+/*并查集(不相交集合)，元素为0--size-1
+合并时把小的集合连到大的集合上(按大小合并)，查找时把经过的每个结点连到祖父结点上(路径减半)，两者结合后单次操作均摊O(α(size))
+同时维护每个集合的大小和集合的数量，可以用于Kruskal算法和边流上的增量连通性查询
+模板IT为下标类型，只能为无符号整型，元素不超过4G个时可以用unsigned(32位)，内存占用减半且对缓存更友好*/
+template<class IT = size_t>
+class DisjointSet
+{
+public:
+
+	static_assert(std::is_integral<IT>::value && std::is_unsigned<IT>::value, "类型IT必须为无符号整型");
+
+	DisjointSet() = default;
+	explicit DisjointSet(size_t size);
+
+	/*初始化为size个单元素集合 O(size)*/
+	void Init(size_t size);
+
+	/*合并x与y所在的集合，已经在同一个集合中时返回false 均摊O(α)*/
+	bool Unite(IT x, IT y);
+
+	/*依次合并[first, last)中每个元素的两端，两端为std::get<0>(e)与std::get<1>(e)(如std::pair、std::tuple)
+	只剩一个集合时提前结束，返回合并成功的次数 均摊O((last-first)*α)*/
+	template<class Iter>
+	size_t UniteAll(Iter first, Iter last);
+
+	/*同上，每次合并成功时调用func(e)，按顺序传入有序的边即为Kruskal算法*/
+	template<class Iter, class F>
+	size_t UniteAll(Iter first, Iter last, F func);
+
+	/*查找x所在集合的根，同时进行路径减半 均摊O(α)*/
+	IT FindRoot(IT x);
+
+	/*x与y是否在同一个集合中 均摊O(α)*/
+	bool Same(IT x, IT y);
+
+	/*x所在集合的元素数量 均摊O(α)*/
+	size_t GetSetSize(IT x);
+
+	/*集合的数量 O(1)*/
+	size_t GetSetNum()const;
+
+	/*元素的数量 O(1)*/
+	size_t GetSize()const;
+
+	/*是否为空 O(1)*/
+	bool IsEmpty()const;
+
+	/*清空并释放内存*/
+	void Clear();
+
+private:
+	std::vector<IT> m_parent;
+	std::vector<IT> m_size;		//只有根的值有意义
+	size_t m_setNum = 0;
+};
+
+template<class IT>
+inline DisjointSet<IT>::DisjointSet(size_t size)
+{
+	Init(size);
+}
+
+template<class IT>
+inline void DisjointSet<IT>::Init(size_t size)
+{
+	m_parent.resize(size);
+	for (size_t i = 0; i < size; ++i)
+		m_parent[i] = (IT)i;
+	m_size.assign(size, (IT)1);
+	m_setNum = size;
+}
+
+template<class IT>
+inline bool DisjointSet<IT>::Unite(IT x, IT y)
+{
+	x = FindRoot(x);
+	y = FindRoot(y);
+	if (x == y)
+		return false;
+	if (m_size[x] < m_size[y])
+		std::swap(x, y);
+	m_parent[y] = x;
+	m_size[x] += m_size[y];
+	--m_setNum;
+	return true;
+}
+
+template<class IT>
+template<class Iter>
+inline size_t DisjointSet<IT>::UniteAll(Iter first, Iter last)
+{
+	return UniteAll(first, last, [](const auto&) {});
+}
+
+template<class IT>
+template<class Iter, class F>
+inline size_t DisjointSet<IT>::UniteAll(Iter first, Iter last, F func)
+{
+	size_t count = 0;
+	for (; first != last && m_setNum > 1; ++first)
+	{
+		if (Unite((IT)std::get<0>(*first), (IT)std::get<1>(*first)))
+		{
+			func(*first);
+			++count;
+		}
+	}
+	return count;
+}
+
+template<class IT>
+inline IT DisjointSet<IT>::FindRoot(IT x)
+{
+	while (m_parent[x] != x)
+	{
+		m_parent[x] = m_parent[m_parent[x]];
+		x = m_parent[x];
+	}
+	return x;
+}
+
+template<class IT>
+inline bool DisjointSet<IT>::Same(IT x, IT y)
+{
+	return FindRoot(x) == FindRoot(y);
+}
+
+template<class IT>
+inline size_t DisjointSet<IT>::GetSetSize(IT x)
+{
+	return m_size[FindRoot(x)];
+}
+
+template<class IT>
+inline size_t DisjointSet<IT>::GetSetNum() const
+{
+	return m_setNum;
+}
+
+template<class IT>
+inline size_t DisjointSet<IT>::GetSize() const
+{
+	return m_parent.size();
+}
+
+template<class IT>
+inline bool DisjointSet<IT>::IsEmpty() const
+{
+	return m_parent.empty();
+}
+
+template<class IT>
+inline void DisjointSet<IT>::Clear()
+{
+	std::vector<IT>().swap(m_parent);
+	std::vector<IT>().swap(m_size);
+	m_setNum = 0;
+}
+
+/*32位下标的并查集，元素不超过4G个时使用*/
+typedef DisjointSet<unsigned> CompactDisjointSet;
+
+/*无锁并查集，FindRoot与Unite可以在多个线程中同时调用，用于并行的Boruvka算法
+合并时总是把下标大的根连到下标小的根上，双亲的下标单调减小，并发合并也不会成环
+查找时用CAS做路径减半，CAS失败说明其它线程已经修改过，直接忽略即可*/
+class ConcurrentDisjointSet
+{
+public:
+
+	ConcurrentDisjointSet() = default;
+	explicit ConcurrentDisjointSet(size_t size);
+
+	/*初始化为size个单元素集合，不能与其它操作同时调用 O(size)*/
+	void Init(size_t size);
+
+	/*合并，x与y已经在同一个集合中时返回false*/
+	bool Unite(size_t x, size_t y);
+
+	/*查找根，有并发合并时返回的根可能马上就不是根了*/
+	size_t FindRoot(size_t x);
+
+	bool Same(size_t x, size_t y);
+
+	/*元素的数量 O(1)*/
+	size_t GetSize()const;
+
+	/*清空并释放内存*/
+	void Clear();
+
+private:
+	std::vector<std::atomic<size_t>> m_data;
+};
+
+inline ConcurrentDisjointSet::ConcurrentDisjointSet(size_t size)
+{
+	Init(size);
+}
+
+inline void ConcurrentDisjointSet::Init(size_t size)
+{
+	m_data = std::vector<std::atomic<size_t>>(size);
+	for (size_t i = 0; i < size; ++i)
+		m_data[i].store(i, std::memory_order_relaxed);
+}
+
+inline bool ConcurrentDisjointSet::Unite(size_t x, size_t y)
+{
+	while (true)
+	{
+		x = FindRoot(x);
+		y = FindRoot(y);
+		if (x == y)
+			return false;
+		if (x < y)
+			std::swap(x, y);
+		size_t expected = x;
+		if (m_data[x].compare_exchange_strong(expected, y, std::memory_order_relaxed)) //x仍然是根时才能合并，否则重新查找
+			return true;
+	}
+}
+
+inline size_t ConcurrentDisjointSet::FindRoot(size_t x)
+{
+	size_t parent = m_data[x].load(std::memory_order_relaxed);
+	while (parent != x)
+	{
+		size_t grand = m_data[parent].load(std::memory_order_relaxed);
+		if (grand != parent) //路径减半
+			m_data[x].compare_exchange_weak(parent, grand, std::memory_order_relaxed);
+		x = grand;
+		parent = m_data[x].load(std::memory_order_relaxed);
+	}
+	return x;
+}
+
+inline bool ConcurrentDisjointSet::Same(size_t x, size_t y)
+{
+	return FindRoot(x) == FindRoot(y);
+}
+
+inline size_t ConcurrentDisjointSet::GetSize() const
+{
+	return m_data.size();
+}
+
+inline void ConcurrentDisjointSet::Clear()
+{
+	std::vector<std::atomic<size_t>>().swap(m_data);
+}
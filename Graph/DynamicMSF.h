@@ -0,0 +1,571 @@
+﻿#pragma once
+
+#include <type_traits>
+#include <functional>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include "MST.h"
+
+/*动态最小生成森林，图的边插入或删除后增量维护，不需要重新计算
+生成森林用link-cut tree维护，每条树边也是一个结点，可以在O(log(VertexNum))内查询两点间路径上最重的树边
+插入：两端不连通时直接成为树边，否则与两端路径上最重的树边比较，更轻时替换它，均摊O(log(VertexNum))
+删除：非树边直接删除；删除树边后从两端交替在树上做bfs，先结束的一侧较小，在这一侧的非树边中找最轻的连到另一侧的边作为替代
+	复杂度O(log(VertexNum)+较小一侧的顶点数与非树边数)，不需要遍历整个图
+GetTotalWeight为O(1)，Foreach为O(生成森林的边数)，两者在每次更新后都是最新的
+W为边的权重类型，与图相同，WT为总权重类型*/
+template<class W = int, class WT = double>
+class DynamicMSF
+{
+public:
+
+	static_assert(std::is_arithmetic<W>::value, "类型W必须为算数类型");
+	static_assert(std::is_arithmetic<WT>::value, "类型WT必须为算数类型");
+
+	/*用MST::GetBoruvkaMSF计算g的最小生成森林，再从它构造 O(EdgeNum*log(VertexNum))*/
+	template<class T>
+	void Build(const GraphBase<T, W>& g);
+
+	/*从g和它的最小生成森林mst构造，mst中的边为树边，g中的其它边为非树边 O(EdgeNum*log(VertexNum))*/
+	template<class T, class PT>
+	void Build(const GraphBase<T, W>& g, const MST_Edge<PT, WT, W>& mst);
+
+	/*图中插入边v1-v2后调用，顶点下标超出范围时自动扩充 均摊O(log(VertexNum))*/
+	void InsertEdge(size_t v1, size_t v2, W weight);
+
+	/*图中删除边v1-v2后调用，有多条重边时删除最重的一条，没有这条边时返回false*/
+	bool RemoveEdge(size_t v1, size_t v2);
+
+	/*v1与v2是否连通 均摊O(log(VertexNum))*/
+	bool IsConnected(size_t v1, size_t v2);
+
+	/*生成森林的总权重 O(1)*/
+	WT GetTotalWeight()const;
+
+	/*生成森林的边数 O(1)*/
+	size_t GetEdgeNum()const;
+
+	/*顶点数量 O(1)*/
+	size_t GetVertexNum()const;
+
+	/*遍历生成森林的边 O(生成森林的边数)*/
+	void Foreach(std::function<void(size_t, size_t, W)> func)const;
+
+	/*清除*/
+	void Clear();
+
+	/*是否为空 O(1)*/
+	bool IsEmpty()const;
+
+private:
+
+	static constexpr size_t NPOS = (size_t)-1;
+
+	/*边，node为树边在link-cut tree中的结点，非树边为0*/
+	struct _Edge
+	{
+		size_t v1, v2;
+		W weight;
+		size_t node;
+		size_t pos[2];		//在两端邻接表中的下标，自环不在邻接表中
+		size_t treePos;		//在m_treeEdges中的下标
+		typename std::multimap<std::pair<size_t, size_t>, size_t>::iterator index;
+	};
+
+	/*link-cut tree的结点，顶点与树边都是结点，0号结点为空结点*/
+	struct _Node
+	{
+		size_t child[2];
+		size_t parent;
+		size_t max;		//splay子树中最重的树边结点，没有时为0
+		size_t edge;	//树边的下标，顶点为NPOS
+		bool reverse;
+	};
+
+	std::vector<_Edge> m_edges;
+	std::vector<size_t> m_freeEdges;
+	std::multimap<std::pair<size_t, size_t>, size_t> m_index;	//(小的顶点，大的顶点)到边
+	std::vector<std::vector<size_t>> m_adjacency;				//每个顶点的所有边(树边和非树边)
+	std::vector<size_t> m_treeEdges;
+	std::vector<_Node> m_nodes{ _Node{ { 0, 0 }, 0, 0, NPOS, false } };
+	std::vector<size_t> m_freeNodes;
+	std::vector<size_t> m_vertexNode;
+	WT m_totalWeight = 0;
+
+	//删除树边时bfs的工作空间，按时间戳复用
+	std::vector<size_t> m_mark;
+	std::vector<char> m_side;
+	size_t m_stamp = 0;
+	std::vector<size_t> m_queue[2];
+	std::vector<size_t> m_stack;
+
+	/*保证顶点num-1存在*/
+	void Reserve(size_t num);
+
+	/*添加一条边(不改变树)，返回下标*/
+	size_t AddEdge(size_t v1, size_t v2, W weight);
+
+	/*把边e变为树边并连接到生成森林，两端必须不连通*/
+	void LinkEdge(size_t e);
+
+	/*把树边e从生成森林中断开，变为非树边*/
+	void CutEdge(size_t e);
+
+	/*从邻接表与索引中删除边e并回收*/
+	void EraseEdge(size_t e);
+
+	/*树边e删除后，在两侧之间找最轻的非树边作为替代，没有时返回NPOS*/
+	size_t FindReplacement(size_t v1, size_t v2);
+
+	size_t NewNode(size_t edge);
+	bool IsSplayRoot(size_t x)const;
+	size_t Heavier(size_t a, size_t b)const;
+	void PushUp(size_t x);
+	void PushDown(size_t x);
+	void Reverse(size_t x);
+	void Rotate(size_t x);
+	void Splay(size_t x);
+	void Access(size_t x);
+	void MakeRoot(size_t x);
+	size_t FindRoot(size_t x);
+	void Link(size_t x, size_t y);
+	void Cut(size_t x, size_t y);
+
+	/*x到y的路径上最重的树边结点，x与y必须连通*/
+	size_t PathMax(size_t x, size_t y);
+};
+
+template<class W, class WT>
+template<class T>
+inline void DynamicMSF<W, WT>::Build(const GraphBase<T, W>& g)
+{
+	Build(g, MST::GetBoruvkaMSF<WT, size_t>(g));
+}
+
+template<class W, class WT>
+template<class T, class PT>
+inline void DynamicMSF<W, WT>::Build(const GraphBase<T, W>& g, const MST_Edge<PT, WT, W>& mst)
+{
+	Clear();
+	Reserve(g.GetVertexNum());
+	mst.Foreach([&](PT v1, PT v2, W w)
+		{
+			LinkEdge(AddEdge(v1, v2, w));
+		});
+	std::vector<size_t> used(m_edges.size(), 0); //树边在g中已经匹配过
+	g.ForeachEdge([&](auto v1, auto v2, auto w)
+		{
+			auto range = m_index.equal_range(std::minmax((size_t)v1, (size_t)v2));
+			for (auto i = range.first; i != range.second; ++i)
+			{
+				if (i->second < used.size() && !used[i->second] && !(m_edges[i->second].weight < (W)w) && !((W)w < m_edges[i->second].weight))
+				{
+					used[i->second] = 1;
+					return;
+				}
+			}
+			AddEdge(v1, v2, w);
+		});
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::InsertEdge(size_t v1, size_t v2, W weight)
+{
+	Reserve(std::max(v1, v2) + 1);
+	size_t e = AddEdge(v1, v2, weight);
+	if (v1 == v2) //自环永远不是树边
+		return;
+	size_t x = m_vertexNode[v1], y = m_vertexNode[v2];
+	if (FindRoot(x) != FindRoot(y))
+	{
+		LinkEdge(e);
+		return;
+	}
+	size_t old = m_nodes[PathMax(x, y)].edge; //环上最重的边
+	if (weight < m_edges[old].weight)
+	{
+		CutEdge(old);
+		LinkEdge(e);
+	}
+}
+
+template<class W, class WT>
+inline bool DynamicMSF<W, WT>::RemoveEdge(size_t v1, size_t v2)
+{
+	if (std::max(v1, v2) >= GetVertexNum())
+		return false;
+	auto range = m_index.equal_range(std::minmax(v1, v2));
+	if (range.first == range.second)
+		return false;
+	size_t e = range.first->second;
+	for (auto i = range.first; i != range.second; ++i) //重边删除最重的，尽量不改变生成森林
+		if (m_edges[e].weight < m_edges[i->second].weight || (!(m_edges[i->second].weight < m_edges[e].weight) && !m_edges[i->second].node))
+			e = i->second;
+	bool isTree = m_edges[e].node != 0;
+	if (isTree)
+		CutEdge(e);
+	EraseEdge(e);
+	if (isTree)
+	{
+		size_t r = FindReplacement(v1, v2);
+		if (r != NPOS)
+			LinkEdge(r);
+	}
+	return true;
+}
+
+template<class W, class WT>
+inline bool DynamicMSF<W, WT>::IsConnected(size_t v1, size_t v2)
+{
+	return FindRoot(m_vertexNode[v1]) == FindRoot(m_vertexNode[v2]);
+}
+
+template<class W, class WT>
+inline WT DynamicMSF<W, WT>::GetTotalWeight() const
+{
+	return m_totalWeight;
+}
+
+template<class W, class WT>
+inline size_t DynamicMSF<W, WT>::GetEdgeNum() const
+{
+	return m_treeEdges.size();
+}
+
+template<class W, class WT>
+inline size_t DynamicMSF<W, WT>::GetVertexNum() const
+{
+	return m_vertexNode.size();
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::Foreach(std::function<void(size_t, size_t, W)> func) const
+{
+	for (auto e : m_treeEdges)
+		func(m_edges[e].v1, m_edges[e].v2, m_edges[e].weight);
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::Clear()
+{
+	std::vector<_Edge>().swap(m_edges);
+	std::vector<size_t>().swap(m_freeEdges);
+	m_index.clear();
+	std::vector<std::vector<size_t>>().swap(m_adjacency);
+	std::vector<size_t>().swap(m_treeEdges);
+	m_nodes.resize(1);
+	m_nodes.shrink_to_fit();
+	std::vector<size_t>().swap(m_freeNodes);
+	std::vector<size_t>().swap(m_vertexNode);
+	std::vector<size_t>().swap(m_mark);
+	std::vector<char>().swap(m_side);
+	m_stamp = 0;
+	m_totalWeight = 0;
+}
+
+template<class W, class WT>
+inline bool DynamicMSF<W, WT>::IsEmpty() const
+{
+	return m_vertexNode.empty();
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::Reserve(size_t num)
+{
+	while (m_vertexNode.size() < num)
+		m_vertexNode.push_back(NewNode(NPOS));
+	if (m_adjacency.size() < num)
+	{
+		m_adjacency.resize(num);
+		m_mark.resize(num, 0);
+		m_side.resize(num, 0);
+	}
+}
+
+template<class W, class WT>
+inline size_t DynamicMSF<W, WT>::AddEdge(size_t v1, size_t v2, W weight)
+{
+	size_t e;
+	if (m_freeEdges.empty())
+	{
+		e = m_edges.size();
+		m_edges.emplace_back();
+	}
+	else
+	{
+		e = m_freeEdges.back();
+		m_freeEdges.pop_back();
+	}
+	auto& edge = m_edges[e];
+	edge.v1 = v1;
+	edge.v2 = v2;
+	edge.weight = weight;
+	edge.node = 0;
+	edge.treePos = NPOS;
+	edge.index = m_index.emplace(std::minmax(v1, v2), e);
+	if (v1 != v2)
+	{
+		edge.pos[0] = m_adjacency[v1].size();
+		m_adjacency[v1].push_back(e);
+		edge.pos[1] = m_adjacency[v2].size();
+		m_adjacency[v2].push_back(e);
+	}
+	return e;
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::LinkEdge(size_t e)
+{
+	auto& edge = m_edges[e];
+	edge.node = NewNode(e);
+	edge.treePos = m_treeEdges.size();
+	m_treeEdges.push_back(e);
+	m_totalWeight += edge.weight;
+	Link(m_vertexNode[edge.v1], edge.node);
+	Link(edge.node, m_vertexNode[edge.v2]);
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::CutEdge(size_t e)
+{
+	auto& edge = m_edges[e];
+	Cut(m_vertexNode[edge.v1], edge.node);
+	Cut(edge.node, m_vertexNode[edge.v2]);
+	m_freeNodes.push_back(edge.node);
+	edge.node = 0;
+	m_edges[m_treeEdges.back()].treePos = edge.treePos;
+	m_treeEdges[edge.treePos] = m_treeEdges.back();
+	m_treeEdges.pop_back();
+	edge.treePos = NPOS;
+	m_totalWeight -= edge.weight;
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::EraseEdge(size_t e)
+{
+	auto& edge = m_edges[e];
+	if (edge.v1 != edge.v2)
+	{
+		for (size_t k = 0; k < 2; ++k) //与邻接表最后一条边交换后删除
+		{
+			auto& adjacency = m_adjacency[k ? edge.v2 : edge.v1];
+			size_t last = adjacency.back();
+			auto& lastEdge = m_edges[last];
+			lastEdge.pos[lastEdge.v1 == (k ? edge.v2 : edge.v1) ? 0 : 1] = edge.pos[k];
+			adjacency[edge.pos[k]] = last;
+			adjacency.pop_back();
+		}
+	}
+	m_index.erase(edge.index);
+	m_freeEdges.push_back(e);
+}
+
+template<class W, class WT>
+inline size_t DynamicMSF<W, WT>::FindReplacement(size_t v1, size_t v2)
+{
+	//从两侧交替bfs，每次各收录一个顶点，先结束的一侧是完整的连通分量，且不大于另一侧的两倍
+	++m_stamp;
+	size_t start[2] = { v1, v2 };
+	size_t head[2] = { 0, 0 };
+	for (size_t k = 0; k < 2; ++k)
+	{
+		m_queue[k].assign(1, start[k]);
+		m_mark[start[k]] = m_stamp;
+		m_side[start[k]] = (char)k;
+	}
+	size_t small = 0;
+	for (size_t k = 0;; k ^= 1)
+	{
+		if (head[k] == m_queue[k].size())
+		{
+			small = k;
+			break;
+		}
+		size_t v = m_queue[k][head[k]++];
+		for (auto e : m_adjacency[v])
+		{
+			if (!m_edges[e].node)
+				continue;
+			size_t to = m_edges[e].v1 == v ? m_edges[e].v2 : m_edges[e].v1;
+			if (m_mark[to] != m_stamp)
+			{
+				m_mark[to] = m_stamp;
+				m_side[to] = (char)k;
+				m_queue[k].push_back(to);
+			}
+		}
+	}
+	//较小一侧的非树边中，另一端不在这一侧的就连到了另一侧(非树边的两端总是连通的)
+	size_t best = NPOS;
+	for (auto v : m_queue[small])
+	{
+		for (auto e : m_adjacency[v])
+		{
+			if (m_edges[e].node)
+				continue;
+			size_t to = m_edges[e].v1 == v ? m_edges[e].v2 : m_edges[e].v1;
+			if (m_mark[to] == m_stamp && m_side[to] == (char)small)
+				continue;
+			if (best == NPOS || m_edges[e].weight < m_edges[best].weight)
+				best = e;
+		}
+	}
+	return best;
+}
+
+template<class W, class WT>
+inline size_t DynamicMSF<W, WT>::NewNode(size_t edge)
+{
+	size_t x;
+	if (m_freeNodes.empty())
+	{
+		x = m_nodes.size();
+		m_nodes.emplace_back();
+	}
+	else
+	{
+		x = m_freeNodes.back();
+		m_freeNodes.pop_back();
+	}
+	m_nodes[x] = _Node{ { 0, 0 }, 0, edge == NPOS ? 0 : x, edge, false };
+	return x;
+}
+
+template<class W, class WT>
+inline bool DynamicMSF<W, WT>::IsSplayRoot(size_t x) const
+{
+	size_t p = m_nodes[x].parent;
+	return p == 0 || (m_nodes[p].child[0] != x && m_nodes[p].child[1] != x);
+}
+
+template<class W, class WT>
+inline size_t DynamicMSF<W, WT>::Heavier(size_t a, size_t b) const
+{
+	if (a == 0)
+		return b;
+	if (b == 0)
+		return a;
+	return m_edges[m_nodes[b].edge].weight > m_edges[m_nodes[a].edge].weight ? b : a;
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::PushUp(size_t x)
+{
+	auto& node = m_nodes[x];
+	node.max = Heavier(Heavier(node.edge == NPOS ? 0 : x, m_nodes[node.child[0]].max), m_nodes[node.child[1]].max);
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::PushDown(size_t x)
+{
+	if (!m_nodes[x].reverse)
+		return;
+	for (auto c : m_nodes[x].child)
+		if (c)
+			Reverse(c);
+	m_nodes[x].reverse = false;
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::Reverse(size_t x)
+{
+	std::swap(m_nodes[x].child[0], m_nodes[x].child[1]);
+	m_nodes[x].reverse = !m_nodes[x].reverse;
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::Rotate(size_t x)
+{
+	size_t y = m_nodes[x].parent, z = m_nodes[y].parent;
+	size_t k = m_nodes[y].child[1] == x;
+	if (!IsSplayRoot(y))
+		m_nodes[z].child[m_nodes[z].child[1] == y] = x;
+	m_nodes[x].parent = z;
+	size_t c = m_nodes[x].child[k ^ 1];
+	m_nodes[y].child[k] = c;
+	if (c)
+		m_nodes[c].parent = y;
+	m_nodes[x].child[k ^ 1] = y;
+	m_nodes[y].parent = x;
+	PushUp(y);
+	PushUp(x);
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::Splay(size_t x)
+{
+	m_stack.assign(1, x); //先从上到下下传翻转标记
+	for (size_t y = x; !IsSplayRoot(y); y = m_nodes[y].parent)
+		m_stack.push_back(m_nodes[y].parent);
+	for (auto i = m_stack.rbegin(); i != m_stack.rend(); ++i)
+		PushDown(*i);
+	while (!IsSplayRoot(x))
+	{
+		size_t y = m_nodes[x].parent, z = m_nodes[y].parent;
+		if (!IsSplayRoot(y))
+			Rotate((m_nodes[y].child[1] == x) == (m_nodes[z].child[1] == y) ? y : x);
+		Rotate(x);
+	}
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::Access(size_t x)
+{
+	for (size_t last = 0; x; last = x, x = m_nodes[x].parent)
+	{
+		Splay(x);
+		m_nodes[x].child[1] = last;
+		PushUp(x);
+	}
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::MakeRoot(size_t x)
+{
+	Access(x);
+	Splay(x);
+	Reverse(x);
+}
+
+template<class W, class WT>
+inline size_t DynamicMSF<W, WT>::FindRoot(size_t x)
+{
+	Access(x);
+	Splay(x);
+	PushDown(x);
+	while (m_nodes[x].child[0])
+	{
+		x = m_nodes[x].child[0];
+		PushDown(x);
+	}
+	Splay(x);
+	return x;
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::Link(size_t x, size_t y)
+{
+	MakeRoot(x);
+	m_nodes[x].parent = y;
+}
+
+template<class W, class WT>
+inline void DynamicMSF<W, WT>::Cut(size_t x, size_t y)
+{
+	MakeRoot(x);
+	Access(y);
+	Splay(y);
+	m_nodes[y].child[0] = 0;
+	m_nodes[x].parent = 0;
+	PushUp(y);
+}
+
+template<class W, class WT>
+inline size_t DynamicMSF<W, WT>::PathMax(size_t x, size_t y)
+{
+	MakeRoot(x);
+	Access(y);
+	Splay(y);
+	return m_nodes[y].max;
+}
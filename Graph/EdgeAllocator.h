@@ -0,0 +1,179 @@
+﻿#pragma once
+
+#include <vector>
+#include <cstddef>
+
+/*邻接表图的边节点分配策略，作为模板参数A传入邻接表图中，自定义的分配器需要提供以下成员：
+	static constexpr bool IsBulkFree	//为true时图析构时不再逐个销毁节点，而是由分配器析构时统一释放
+	E* Allocate()						//分配一个节点，不需要初始化
+	void Deallocate(E* e)				//回收一个节点
+	void Reserve(size_t num)			//预留至少num个节点的空间
+	unsigned long long GetMemoryUsage(size_t num)const	//num个节点在使用时，分配器的主要内存占用量(byte)*/
+
+/*默认分配器，每个节点单独new/delete*/
+template<class E>
+class _DefaultEdgeAllocator
+{
+public:
+
+	static constexpr bool IsBulkFree = false;
+
+	/*分配一个节点 O(1)*/
+	E* Allocate();
+
+	/*回收一个节点 O(1)*/
+	void Deallocate(E* e);
+
+	/*无操作*/
+	void Reserve(size_t num);
+
+	/*等于num*sizeof(E)，不包括堆分配器自身的开销*/
+	unsigned long long GetMemoryUsage(size_t num)const;
+};
+
+template<class E>
+inline E* _DefaultEdgeAllocator<E>::Allocate()
+{
+	return new E;
+}
+
+template<class E>
+inline void _DefaultEdgeAllocator<E>::Deallocate(E* e)
+{
+	delete e;
+}
+
+template<class E>
+inline void _DefaultEdgeAllocator<E>::Reserve(size_t /*num*/)
+{
+}
+
+template<class E>
+inline unsigned long long _DefaultEdgeAllocator<E>::GetMemoryUsage(size_t num) const
+{
+	return (unsigned long long)num * sizeof(E);
+}
+
+/*池化分配器，以块为单位申请节点，节点在内存中连续分布，遍历时局部性更好
+回收的节点通过E::next串成空闲链表，下次分配时优先复用
+所有块在分配器析构时统一释放，图析构时不需要遍历所有边
+该分配器不可复制，所以使用该分配器的图也不可复制*/
+template<class E>
+class PooledEdgeAllocator
+{
+public:
+
+	static constexpr bool IsBulkFree = true;
+
+	/*每次申请的最小块大小(节点数)*/
+	static constexpr size_t MinBlockSize = 1024;
+
+	PooledEdgeAllocator() = default;
+	PooledEdgeAllocator(const PooledEdgeAllocator&) = delete;
+	PooledEdgeAllocator(PooledEdgeAllocator&& a);
+	~PooledEdgeAllocator();
+
+	PooledEdgeAllocator& operator=(const PooledEdgeAllocator&) = delete;
+
+	/*分配一个节点，均摊O(1)*/
+	E* Allocate();
+
+	/*将节点放入空闲链表 O(1)*/
+	void Deallocate(E* e);
+
+	/*保证之后至少num个节点不需要再申请块*/
+	void Reserve(size_t num);
+
+	/*释放所有块，之前分配的节点全部失效*/
+	void Release();
+
+	/*实际占用为所有块的大小，与正在使用的节点数量无关*/
+	unsigned long long GetMemoryUsage(size_t num)const;
+
+private:
+
+	std::vector<E*> m_blocks;	//所有块
+	E* m_freeList = nullptr;	//空闲链表
+	E* m_cur = nullptr;			//当前块中未分配的位置
+	E* m_end = nullptr;			//当前块的末尾
+	size_t m_capacity = 0;		//所有块的节点总数
+	size_t m_freeNum = 0;		//空闲链表中的节点数
+
+	/*申请一个新块*/
+	void NewBlock(size_t size);
+};
+
+template<class E>
+inline PooledEdgeAllocator<E>::PooledEdgeAllocator(PooledEdgeAllocator&& a) :
+	m_blocks(std::move(a.m_blocks)), m_freeList(a.m_freeList), m_cur(a.m_cur), m_end(a.m_end),
+	m_capacity(a.m_capacity), m_freeNum(a.m_freeNum)
+{
+	a.m_blocks.clear();
+	a.m_freeList = a.m_cur = a.m_end = nullptr;
+	a.m_capacity = a.m_freeNum = 0;
+}
+
+template<class E>
+inline PooledEdgeAllocator<E>::~PooledEdgeAllocator()
+{
+	Release();
+}
+
+template<class E>
+inline E* PooledEdgeAllocator<E>::Allocate()
+{
+	if (m_freeList != nullptr)
+	{
+		E* e = m_freeList;
+		m_freeList = e->next;
+		--m_freeNum;
+		return e;
+	}
+	if (m_cur == m_end) //块用完了，新块大小与已有容量相同，保证均摊O(1)
+		NewBlock(m_capacity < MinBlockSize ? MinBlockSize : m_capacity);
+	return m_cur++;
+}
+
+template<class E>
+inline void PooledEdgeAllocator<E>::Deallocate(E* e)
+{
+	e->next = m_freeList;
+	m_freeList = e;
+	++m_freeNum;
+}
+
+template<class E>
+inline void PooledEdgeAllocator<E>::Reserve(size_t num)
+{
+	size_t available = m_freeNum + (size_t)(m_end - m_cur);
+	if (num > available)
+		NewBlock(num - available);
+}
+
+template<class E>
+inline void PooledEdgeAllocator<E>::Release()
+{
+	for (auto i : m_blocks)
+		delete[] i;
+	m_blocks.clear();
+	m_freeList = m_cur = m_end = nullptr;
+	m_capacity = m_freeNum = 0;
+}
+
+template<class E>
+inline unsigned long long PooledEdgeAllocator<E>::GetMemoryUsage(size_t num) const
+{
+	return (unsigned long long)m_capacity * sizeof(E) + (unsigned long long)m_blocks.capacity() * sizeof(E*) + sizeof(m_blocks);
+}
+
+template<class E>
+inline void PooledEdgeAllocator<E>::NewBlock(size_t size)
+{
+	//当前块剩下的节点放入空闲链表，不浪费
+	while (m_cur != m_end)
+		Deallocate(m_cur++);
+	m_cur = new E[size];
+	m_end = m_cur + size;
+	m_blocks.push_back(m_cur);
+	m_capacity += size;
+}
@@ -8,5 +8,15 @@
 #include "UnweightedDirectedLinkGraph.h"
 #include "WeightedUndirectedLinkGraph.h"
 #include "WeightedDirectedLinkGraph.h"
+#include "UnweightedUndirectedArrayGraph.h"
+#include "UnweightedDirectedArrayGraph.h"
+#include "WeightedUndirectedArrayGraph.h"
+#include "WeightedDirectedArrayGraph.h"
+#include "CSRGraph.h"
+#include "VertexIndexedGraph.h"
+#include "DisjointSet.h"
 #include "MST.h"
 #include "ShortestPath.h"
+#include "ContractionHierarchy.h"
+#include "LandmarkOracle.h"
+#include "DynamicMSF.h"
@@ -5,6 +5,8 @@
 #include <stdexcept>
 #include <cstring>
 #include <queue>
+#include <tuple>
+#include <algorithm>
 
 /*
 T为顶点类型，W为权重类型
@@ -26,6 +28,8 @@ public:
 	using OnPassVertex = std::function<void(VertexPosType)>;
 	/*边遍历的回调函数*/
 	using OnPassEdge = std::function<void(VertexPosType from, VertexPosType to, const W& weight)>;
+	/*边的三元组(from, to, weight)，用于批量插入边*/
+	using EdgeTuple = std::tuple<VertexPosType, VertexPosType, W>;
 	/*无效下标，仅用来标记下标查找的结果*/
 	static constexpr auto NPOS = static_cast<size_t>(-1);
 
@@ -35,6 +39,15 @@ public:
 	/*插入或删除一条边，对于无向图，两个参数顺序无所谓*/
 	virtual void InsertEdge(VertexPosType from, VertexPosType to, const W& weight) = 0;
 
+	/*批量插入边，[first, last)中的元素需要能用std::get<0/1/2>获取from/to/weight，如std::tuple
+	会先排序去重，重复的边以第一次出现的为准，已经存在的边以及权重为0的边会被忽略
+	邻接表图中只需要遍历一次相关顶点的邻接表 O(k*log(k)+相关顶点的VertexEdgeNum之和)，k为插入边的数量*/
+	template<class It>
+	void InsertEdges(It first, It last);
+
+	/*预留空间，vertexNum与edgeNum为预计的顶点总数与边总数，只用来减少内存的重新分配，不会改变图*/
+	virtual void Reserve(size_t vertexNum, size_t edgeNum);
+
 	/*查找是否存在顶点 O(VertexNum)*/
 	virtual bool ExistVertex(const T& v)const;
 
@@ -50,6 +63,22 @@ public:
 	/*删除顶点，删完后下标会改变*/
 	virtual void RemoveVertex(VertexPosType v) = 0;
 
+	/*标记删除顶点，只删除与v相关的边，所有顶点的下标都不变，之后插入的顶点会优先复用被标记删除的下标
+	被标记删除的顶点不会出现在ForeachVertex/GetVertexPos/ExistVertex中，需要重新编号时调用@Compact
+	默认先遍历出入邻接点再逐条删除边，复杂度为ForeachOutNeighbor+ForeachInNeighbor+删除边的开销*/
+	virtual void LazyRemoveVertex(VertexPosType v);
+
+	/*真正删除所有被标记删除的顶点，剩下的顶点保持原来的相对顺序重新编号
+	返回旧下标到新下标的映射，被标记删除的顶点映射为NPOS
+	默认对被标记删除的顶点从后往前逐个调用RemoveVertex，邻接表图会重写为O(VertexNum+EdgeNum)*/
+	virtual std::vector<VertexPosType> Compact();
+
+	/*顶点是否被标记删除 O(1)*/
+	bool IsVertexRemoved(VertexPosType v)const;
+
+	/*获取被标记删除的顶点数 O(1)*/
+	size_t GetRemovedVertexNum()const;
+
 	/*删除边*/
 	virtual void RemoveEdge(VertexPosType from, VertexPosType to) = 0;
 
@@ -72,7 +101,7 @@ public:
 	/*遍历入邻接点(在无向图中与@GetOutNeighbor功能相同)*/
 	virtual void ForeachInNeighbor(VertexPosType v, OnPassEdge func)const = 0;
 
-	/*获取顶点数 O(1)*/
+	/*获取顶点数，包括被标记删除的顶点，即下标的上界 O(1)*/
 	virtual size_t GetVertexNum()const;
 
 	/*获取边数 O(1)*/
@@ -84,7 +113,7 @@ public:
 	/*从v开始BFS遍历*/
 	virtual void BFS(VertexPosType v, OnPassVertex func)const;
 
-	/*遍历所有顶点 O(VertexNum)*/
+	/*遍历所有顶点，跳过被标记删除的顶点 O(VertexNum)*/
 	virtual void ForeachVertex(OnPassVertex func)const;
 
 	/*遍历所有边*/
@@ -106,27 +135,114 @@ public:
 protected:
 	std::vector<T> m_vertexData;
 	size_t m_edgeNum = 0;
+	std::vector<bool> m_removed;				//顶点是否被标记删除，长度可能小于顶点数，超出的部分视为未删除
+	std::vector<VertexPosType> m_freeSlots;		//被标记删除、可以复用的下标
+
+	/*有被标记删除的下标时，将v放入该下标中并返回true，实现类的InsertVertex需要先调用它 O(1)*/
+	bool ReuseRemovedSlot(const T& v, VertexPosType& pos);
+
+	/*从顶点数组中删除v，并修正标记删除的信息，实现类的RemoveVertex需要用它删除顶点数据*/
+	void EraseVertexData(VertexPosType v);
+
+	/*计算Compact的下标映射，被标记删除的顶点映射为NPOS O(VertexNum)*/
+	std::vector<VertexPosType> GetCompactMapping()const;
+
+	/*按映射压缩顶点数组，并清空标记删除的信息 O(VertexNum)*/
+	void CompactVertexData(const std::vector<VertexPosType>& mapping);
+
+	/*批量插入边的实现，edges可以随意修改，默认排序去重后逐条调用InsertEdge*/
+	virtual void BulkInsertEdges(std::vector<EdgeTuple>& edges);
+
+	/*去掉权重为0的边，按(from, to)排序并去重，重复的边保留第一次出现的
+	无向图会先把每条边调整为from<=to*/
+	static void SortUniqueEdges(std::vector<EdgeTuple>& edges, bool isDirected);
+
+	/*为每条非自环的边添加一条反向边并重新排序，用于无向图的邻接表*/
+	static void MirrorEdges(std::vector<EdgeTuple>& edges);
 
 };
 
 template<class T, class W>
 inline bool GraphBase<T, W>::ExistVertex(const T& v) const
 {
-	for (auto i : m_vertexData)
-		if (i == v)
-			return true;
-	return false;
+	return GetVertexPos(v) != NPOS;
+}
+
+template<class T, class W>
+template<class It>
+inline void GraphBase<T, W>::InsertEdges(It first, It last)
+{
+	std::vector<EdgeTuple> edges;
+	for (; first != last; ++first)
+		edges.emplace_back((VertexPosType)std::get<0>(*first), (VertexPosType)std::get<1>(*first), (W)std::get<2>(*first));
+	BulkInsertEdges(edges);
+}
+
+template<class T, class W>
+inline void GraphBase<T, W>::Reserve(size_t vertexNum, size_t /*edgeNum*/)
+{
+	m_vertexData.reserve(vertexNum);
 }
 
 template<class T, class W>
 inline size_t GraphBase<T, W>::GetVertexPos(const T& v)const
 {
 	for (size_t i = 0; i < m_vertexData.size(); ++i)
-		if (m_vertexData[i] == v)
+		if (m_vertexData[i] == v && !IsVertexRemoved(i))
 			return i;
 	return NPOS;
 }
 
+template<class T, class W>
+inline void GraphBase<T, W>::LazyRemoveVertex(VertexPosType v)
+{
+	if (IsVertexRemoved(v))
+		return;
+	std::vector<VertexPosType> neighbors;
+	ForeachOutNeighbor(v, [&](auto i)
+		{
+			neighbors.push_back(i);
+		});
+	for (auto i : neighbors)
+		RemoveEdge(v, i);
+	if (IsDirected()) //无向图的入边就是出边，已经删掉了
+	{
+		neighbors.clear();
+		ForeachInNeighbor(v, [&](auto i)
+			{
+				neighbors.push_back(i);
+			});
+		for (auto i : neighbors)
+			RemoveEdge(i, v);
+	}
+	if (m_removed.size() < m_vertexData.size())
+		m_removed.resize(m_vertexData.size(), false);
+	m_removed[v] = true;
+	m_freeSlots.push_back(v);
+}
+
+template<class T, class W>
+inline std::vector<typename GraphBase<T, W>::VertexPosType> GraphBase<T, W>::Compact()
+{
+	std::vector<VertexPosType> mapping = GetCompactMapping();
+	for (VertexPosType i = m_vertexData.size(); i-- > 0;) //从后往前删，前面的下标不受影响
+		if (IsVertexRemoved(i))
+			RemoveVertex(i);
+	return mapping;
+}
+
+template<class T, class W>
+inline bool GraphBase<T, W>::IsVertexRemoved(VertexPosType v) const
+{
+	return v < m_removed.size() && m_removed[v];
+}
+
+template<class T, class W>
+inline size_t GraphBase<T, W>::GetRemovedVertexNum() const
+{
+	return m_freeSlots.size();
+}
+
 template<class T, class W>
 inline T& GraphBase<T, W>::GetVertex(VertexPosType pos)
 {
@@ -200,5 +316,103 @@ template<class T, class W>
 inline void GraphBase<T, W>::ForeachVertex(OnPassVertex func) const
 {
 	for (size_t i = 0; i < m_vertexData.size(); ++i)
-		func(i);
+		if (!IsVertexRemoved(i))
+			func(i);
+}
+
+template<class T, class W>
+inline void GraphBase<T, W>::BulkInsertEdges(std::vector<EdgeTuple>& edges)
+{
+	SortUniqueEdges(edges, IsDirected());
+	for (auto& i : edges)
+		InsertEdge(std::get<0>(i), std::get<1>(i), std::get<2>(i));
+}
+
+template<class T, class W>
+inline void GraphBase<T, W>::SortUniqueEdges(std::vector<EdgeTuple>& edges, bool isDirected)
+{
+	auto end = std::remove_if(edges.begin(), edges.end(), [](const EdgeTuple& e)
+		{
+			return std::get<2>(e) == (W)0;
+		});
+	edges.erase(end, edges.end());
+	if (!isDirected)
+		for (auto& i : edges)
+			if (std::get<0>(i) > std::get<1>(i))
+				std::swap(std::get<0>(i), std::get<1>(i));
+	auto less = [](const EdgeTuple& a, const EdgeTuple& b)
+	{
+		return std::get<0>(a) != std::get<0>(b) ? std::get<0>(a) < std::get<0>(b) : std::get<1>(a) < std::get<1>(b);
+	};
+	std::stable_sort(edges.begin(), edges.end(), less); //稳定排序，保证重复的边中第一次出现的排在前面
+	end = std::unique(edges.begin(), edges.end(), [](const EdgeTuple& a, const EdgeTuple& b)
+		{
+			return std::get<0>(a) == std::get<0>(b) && std::get<1>(a) == std::get<1>(b);
+		});
+	edges.erase(end, edges.end());
+}
+
+template<class T, class W>
+inline void GraphBase<T, W>::MirrorEdges(std::vector<EdgeTuple>& edges)
+{
+	size_t size = edges.size();
+	for (size_t i = 0; i < size; ++i)
+		if (std::get<0>(edges[i]) != std::get<1>(edges[i]))
+			edges.emplace_back(std::get<1>(edges[i]), std::get<0>(edges[i]), std::get<2>(edges[i]));
+	std::sort(edges.begin(), edges.end(), [](const EdgeTuple& a, const EdgeTuple& b)
+		{
+			return std::get<0>(a) != std::get<0>(b) ? std::get<0>(a) < std::get<0>(b) : std::get<1>(a) < std::get<1>(b);
+		});
+}
+
+template<class T, class W>
+inline bool GraphBase<T, W>::ReuseRemovedSlot(const T& v, VertexPosType& pos)
+{
+	if (m_freeSlots.empty())
+		return false;
+	pos = m_freeSlots.back();
+	m_freeSlots.pop_back();
+	m_removed[pos] = false;
+	m_vertexData[pos] = v;
+	return true;
+}
+
+template<class T, class W>
+inline void GraphBase<T, W>::EraseVertexData(VertexPosType v)
+{
+	m_vertexData.erase(m_vertexData.begin() + v);
+	if (v >= m_removed.size())
+		return;
+	if (m_removed[v])
+		m_freeSlots.erase(std::find(m_freeSlots.begin(), m_freeSlots.end(), v));
+	m_removed.erase(m_removed.begin() + v);
+	for (auto& i : m_freeSlots)
+		if (i > v)
+			--i;
+}
+
+template<class T, class W>
+inline std::vector<typename GraphBase<T, W>::VertexPosType> GraphBase<T, W>::GetCompactMapping() const
+{
+	std::vector<VertexPosType> mapping(m_vertexData.size());
+	VertexPosType size = 0;
+	for (VertexPosType i = 0; i < m_vertexData.size(); ++i)
+		mapping[i] = IsVertexRemoved(i) ? (VertexPosType)NPOS : size++;
+	return mapping;
+}
+
+template<class T, class W>
+inline void GraphBase<T, W>::CompactVertexData(const std::vector<VertexPosType>& mapping)
+{
+	VertexPosType size = 0;
+	for (VertexPosType i = 0; i < m_vertexData.size(); ++i)
+		if (mapping[i] != NPOS)
+		{
+			if (size != i)
+				m_vertexData[size] = std::move(m_vertexData[i]);
+			++size;
+		}
+	m_vertexData.erase(m_vertexData.begin() + size, m_vertexData.end());
+	m_removed.clear();
+	m_freeSlots.clear();
 }
@@ -0,0 +1,486 @@
+﻿#pragma once
+
+#include <type_traits>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <cstdint>
+#include "GraphBase.h"
+#include "ThreadPool.h"
+
+/*按Align字节对齐分配内存的分配器，用于需要按缓存行对齐的表*/
+template<class T, size_t Align>
+class _AlignedAllocator
+{
+public:
+
+	static_assert(Align >= sizeof(void*) && (Align & (Align - 1)) == 0, "Align必须是2的幂，并且不小于指针大小");
+
+	typedef T value_type;
+
+	template<class U>
+	struct rebind
+	{
+		typedef _AlignedAllocator<U, Align> other;
+	};
+
+	_AlignedAllocator() = default;
+
+	template<class U>
+	_AlignedAllocator(const _AlignedAllocator<U, Align>&) {}
+
+	/*多申请Align+sizeof(void*)字节，原始地址存放在对齐后的地址之前*/
+	T* allocate(size_t n);
+
+	void deallocate(T* p, size_t n);
+
+	template<class U>
+	bool operator==(const _AlignedAllocator<U, Align>&)const { return true; }
+
+	template<class U>
+	bool operator!=(const _AlignedAllocator<U, Align>&)const { return false; }
+};
+
+template<class T, size_t Align>
+inline T* _AlignedAllocator<T, Align>::allocate(size_t n)
+{
+	char* raw = static_cast<char*>(::operator new(n * sizeof(T) + Align + sizeof(void*)));
+	uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + Align - 1) & ~(uintptr_t)(Align - 1);
+	reinterpret_cast<void**>(aligned)[-1] = raw;
+	return reinterpret_cast<T*>(aligned);
+}
+
+template<class T, size_t Align>
+inline void _AlignedAllocator<T, Align>::deallocate(T* p, size_t /*n*/)
+{
+	::operator delete(reinterpret_cast<void**>(p)[-1]);
+}
+
+/*ALT(A*, Landmarks, Triangle inequality)距离预言机，选择k个地标，预处理所有顶点与地标之间的距离
+由三角不等式，对任意地标L：d(v,t)>=d(L,t)-d(L,v)，d(v,t)>=d(v,L)-d(t,L)，取所有地标中最大的作为下界
+	L能到达v但到达不了t，或者t能到达L但v到达不了L时，v一定到达不了t，下界为Infinity
+	这样下界是一致的，可以直接作为AStar的启发函数：astar.Execute(g, src, target, oracle.GetHeuristic(target))，AStar的WT需要与预言机相同
+	min(d(v,L)+d(L,t))是上界，可以用作近似距离
+地标选择：
+	farthest：每次选择离已选地标最远的顶点(不可达的顶点视为无穷远，所以每个连通分量都会有地标)
+	avoid：从一个根做最短路径树，每个顶点的权重为真实距离与当前下界的差，选择下界最差的子树中的叶子作为地标
+	两种策略中每个地标都依赖之前的地标，需要依次选择，有向图还需要到地标的距离，这部分在多个线程中并行计算
+距离表是扁平的，每个顶点一行，按缓存行对齐，有向图每行先存k个d(L,v)再存k个d(v,L)，无向图两者相同只存一份
+WT是权重累加和类型，权重不能为负数*/
+template<class WT>
+class LandmarkOracle
+{
+public:
+
+	static_assert(std::is_arithmetic<WT>::value, "类型WT必须为算数类型");
+
+	/*距离表中表示不可达的值，整型为最大值的一半，浮点型为无穷大*/
+	static constexpr WT Infinity = std::numeric_limits<WT>::has_infinity ? std::numeric_limits<WT>::infinity() : std::numeric_limits<WT>::max() / 2;
+
+	/*距离表每行的对齐字节数*/
+	static constexpr size_t CacheLineSize = 64;
+
+	/*可以传给AStar::Execute的启发函数，返回v到target的下界，v到达不了target时返回WT的最大值(浮点型为无穷大)，AStar会剪掉该顶点*/
+	class Heuristic
+	{
+	public:
+
+		Heuristic(const LandmarkOracle& oracle, size_t target);
+
+		WT operator()(size_t v)const;
+
+	private:
+
+		const LandmarkOracle* m_oracle;
+		size_t m_target;
+	};
+
+	/*threadNum为Build使用的线程数，为0时使用硬件线程数*/
+	explicit LandmarkOracle(size_t threadNum = 0);
+
+	/*选择landmarkNum个地标并计算距离表，avoid为true时使用avoid策略，否则使用farthest策略
+	O(landmarkNum*(VertexNum+EdgeNum)*log(EdgeNum))*/
+	template<class T, class W>
+	void Build(const GraphBase<T, W>& g, size_t landmarkNum, bool avoid = false);
+
+	/*清除*/
+	void Clear();
+
+	/*是否为空 O(1)*/
+	bool IsEmpty()const;
+
+	/*顶点数量 O(1)*/
+	size_t GetVertexNum()const;
+
+	/*地标数量 O(1)*/
+	size_t GetLandmarkNum()const;
+
+	/*第i个地标 O(1)*/
+	size_t GetLandmark(size_t i)const;
+
+	/*设置Build使用的线程数，为0时使用硬件线程数*/
+	void SetThreadNum(size_t threadNum);
+
+	/*获取设置的线程数 O(1)*/
+	size_t GetThreadNum()const;
+
+	/*第i个地标到v的距离，不可达时为Infinity O(1)*/
+	WT GetDistanceFrom(size_t i, size_t v)const;
+
+	/*v到第i个地标的距离，不可达时为Infinity O(1)*/
+	WT GetDistanceTo(size_t i, size_t v)const;
+
+	/*v到target距离的下界，有地标能证明v到达不了target时为Infinity O(LandmarkNum)*/
+	WT GetLowerBound(size_t v, size_t target)const;
+
+	/*v到target距离的上界，经过地标的最短距离，不可达时为Infinity O(LandmarkNum)*/
+	WT GetUpperBound(size_t v, size_t target)const;
+
+	/*获取到target的启发函数 O(1)*/
+	Heuristic GetHeuristic(size_t target)const;
+
+private:
+
+	size_t m_size = 0;
+	size_t m_threadNum;
+	size_t m_stride = 0;			//每行的元素个数，凑整到缓存行
+	bool m_directed = false;
+	std::vector<size_t> m_landmarks;
+	std::vector<WT, _AlignedAllocator<WT, CacheLineSize>> m_table;	//m_table[v*m_stride+i]为d(L_i,v)，有向图m_table[v*m_stride+k+i]为d(v,L_i)
+
+	/*从src开始的dijkstra，reverse为true时沿入边搜索(即求到src的距离)，prev不为空时记录最短路径树*/
+	template<class T, class W>
+	static void Search(const GraphBase<T, W>& g, size_t src, bool reverse, std::vector<WT>& dist, std::vector<size_t>* prev);
+
+	/*farthest策略：minDist为各顶点到已选地标的最小距离，选择其中最大的，没有可选的顶点时返回VertexNum O(VertexNum)*/
+	size_t SelectFarthest(const std::vector<WT>& minDist)const;
+
+	/*avoid策略：从root的最短路径树中选择下界最差的叶子，整棵树都被地标覆盖时返回VertexNum*/
+	template<class T, class W>
+	size_t SelectAvoid(const GraphBase<T, W>& g, size_t root)const;
+
+	/*把dist写入距离表的第column列*/
+	void SetColumn(size_t column, const std::vector<WT>& dist);
+};
+
+/*权重为非负整数的地标预言机*/
+typedef LandmarkOracle<unsigned long long> IntegerLandmarkOracle;
+/*权重为非负小数的地标预言机*/
+typedef LandmarkOracle<double> DecimalLandmarkOracle;
+
+template<class WT>
+inline LandmarkOracle<WT>::Heuristic::Heuristic(const LandmarkOracle& oracle, size_t target) :
+	m_oracle(&oracle), m_target(target)
+{
+}
+
+template<class WT>
+inline WT LandmarkOracle<WT>::Heuristic::operator()(size_t v) const
+{
+	WT bound = m_oracle->GetLowerBound(v, m_target);
+	if (bound == (WT)Infinity) //整型的Infinity只是最大值的一半，换成AStar约定的最大值
+		return std::numeric_limits<WT>::has_infinity ? std::numeric_limits<WT>::infinity() : std::numeric_limits<WT>::max();
+	return bound;
+}
+
+template<class WT>
+inline LandmarkOracle<WT>::LandmarkOracle(size_t threadNum) :
+	m_threadNum(threadNum)
+{
+}
+
+template<class WT>
+template<class T, class W>
+inline void LandmarkOracle<WT>::Build(const GraphBase<T, W>& g, size_t landmarkNum, bool avoid)
+{
+	Clear();
+	size_t num = g.GetVertexNum();
+	if (num == 0 || landmarkNum == 0)
+		return;
+	if (landmarkNum > num)
+		landmarkNum = num;
+	m_size = num;
+	m_directed = g.IsDirected();
+	size_t lineElements = CacheLineSize / sizeof(WT) ? CacheLineSize / sizeof(WT) : 1;
+	size_t columns = m_directed ? landmarkNum * 2 : landmarkNum;
+	m_stride = (columns + lineElements - 1) / lineElements * lineElements;
+	m_table.assign(num * m_stride, (WT)Infinity);
+
+	//依次选择地标，同时计算地标到所有顶点的距离
+	std::vector<WT> dist, minDist(num, (WT)Infinity);	//minDist为到已选地标的最小距离，已经是地标或者已删除的顶点为0
+	size_t root = num;
+	for (size_t v = 0; v < num; ++v)
+		if (g.IsVertexRemoved(v)) //跳过已标记删除的顶点
+			minDist[v] = (WT)0;
+		else if (root == num)
+			root = v;
+	if (root == num)
+	{
+		Clear();
+		return;
+	}
+	for (size_t i = 0; i < landmarkNum; ++i)
+	{
+		size_t landmark = num;
+		if (avoid)
+			landmark = SelectAvoid(g, root);
+		else if (i == 0) //第一个地标为离任意一个顶点最远的顶点
+		{
+			Search(g, root, false, dist, nullptr);
+			for (size_t v = 0; v < num; ++v)
+				if (minDist[v] == (WT)0)
+					dist[v] = (WT)0;
+			landmark = SelectFarthest(dist);
+			if (landmark == num) //只有一个顶点
+				landmark = root;
+		}
+		if (landmark == num) //avoid策略中整棵树都被覆盖了，退回farthest策略
+			landmark = SelectFarthest(minDist);
+		if (landmark == num) //所有顶点都已经是地标了
+			break;
+		m_landmarks.push_back(landmark);
+		Search(g, landmark, false, dist, nullptr);
+		SetColumn(i, dist);
+		minDist[landmark] = (WT)0;
+		for (size_t v = 0; v < num; ++v)
+			if (dist[v] < minDist[v])
+				minDist[v] = dist[v];
+		do //avoid策略每次换一个根
+			root = (root * 2654435761u + 1) % num;
+		while (g.IsVertexRemoved(root));
+	}
+
+	//有向图还需要各顶点到地标的距离，地标之间互相独立，并行计算
+	if (m_directed)
+	{
+		size_t k = GetLandmarkNum();
+		ThreadPool pool(k < 2 ? 1 : m_threadNum);
+		std::vector<std::vector<WT>> buffers(pool.GetThreadNum());
+		pool.Run(k, [&](size_t i, size_t thread)
+			{
+				Search(g, m_landmarks[i], true, buffers[thread], nullptr);
+				SetColumn(k + i, buffers[thread]); //不同的列，互不干扰
+			});
+	}
+}
+
+template<class WT>
+template<class T, class W>
+inline void LandmarkOracle<WT>::Search(const GraphBase<T, W>& g, size_t src, bool reverse, std::vector<WT>& dist, std::vector<size_t>* prev)
+{
+	typedef std::pair<WT, size_t> _HeapNode;
+	std::priority_queue<_HeapNode, std::vector<_HeapNode>, std::greater<_HeapNode>> pq;
+	size_t num = g.GetVertexNum();
+	dist.assign(num, (WT)Infinity);
+	if (prev)
+		prev->assign(num, num);
+	dist[src] = (WT)0;
+	pq.emplace((WT)0, src);
+	while (!pq.empty())
+	{
+		_HeapNode top = pq.top();
+		pq.pop();
+		if (top.first > dist[top.second]) //过期的节点
+			continue;
+		auto relax = [&](size_t next, WT w)
+		{
+			WT d = top.first + w;
+			if (d < dist[next])
+			{
+				dist[next] = d;
+				if (prev)
+					(*prev)[next] = top.second;
+				pq.emplace(d, next);
+			}
+		};
+		if (reverse && g.IsDirected())
+			g.ForeachInNeighbor(top.second, [&](auto from, auto /*to*/, auto w)
+				{
+					relax(from, g.IsWeighted() ? (WT)w : (WT)1);
+				});
+		else
+			g.ForeachOutNeighbor(top.second, [&](auto /*from*/, auto to, auto w)
+				{
+					relax(to, g.IsWeighted() ? (WT)w : (WT)1);
+				});
+	}
+}
+
+template<class WT>
+inline size_t LandmarkOracle<WT>::SelectFarthest(const std::vector<WT>& minDist) const
+{
+	size_t best = m_size;
+	for (size_t v = 0; v < m_size; ++v)
+		if (minDist[v] != (WT)0 && (best == m_size || minDist[v] > minDist[best]))
+			best = v;
+	return best;
+}
+
+template<class WT>
+template<class T, class W>
+inline size_t LandmarkOracle<WT>::SelectAvoid(const GraphBase<T, W>& g, size_t root) const
+{
+	std::vector<WT> dist;
+	std::vector<size_t> prev;
+	Search(g, root, false, dist, &prev);
+
+	//权重为真实距离与下界之差，下界越差权重越大；子树中有地标时整棵子树的大小为0
+	std::vector<size_t> order; //按距离从大到小处理，保证先处理子节点
+	for (size_t v = 0; v < m_size; ++v)
+		if (dist[v] != (WT)Infinity)
+			order.push_back(v);
+	std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return dist[a] > dist[b]; });
+	std::vector<WT> size(m_size, (WT)0);
+	std::vector<bool> hasLandmark(m_size, false);
+	for (auto l : m_landmarks)
+		hasLandmark[l] = true;
+	for (auto v : order)
+	{
+		WT bound = (WT)0;
+		const WT* rv = m_table.data() + v * m_stride;
+		const WT* rr = m_table.data() + root * m_stride;
+		for (size_t i = 0; i < GetLandmarkNum(); ++i)
+			if (rv[i] != (WT)Infinity && rr[i] != (WT)Infinity && rv[i] > rr[i] && rv[i] - rr[i] > bound)
+				bound = rv[i] - rr[i];
+		size[v] += dist[v] - bound;
+		if (prev[v] != m_size)
+		{
+			if (hasLandmark[v])
+				hasLandmark[prev[v]] = true;
+			else
+				size[prev[v]] += size[v];
+		}
+	}
+	for (auto v : order)
+		if (hasLandmark[v])
+			size[v] = (WT)0;
+
+	//从根开始，每次走到size最大的子节点，直到叶子
+	std::vector<size_t> bestChild(m_size, m_size);
+	for (auto v : order)
+		if (v != root && prev[v] != m_size && size[v] > (WT)0 &&
+			(bestChild[prev[v]] == m_size || size[v] > size[bestChild[prev[v]]]))
+			bestChild[prev[v]] = v;
+	size_t v = root;
+	if (size[v] == (WT)0)
+		return m_size;
+	while (bestChild[v] != m_size)
+		v = bestChild[v];
+	return v;
+}
+
+template<class WT>
+inline void LandmarkOracle<WT>::SetColumn(size_t column, const std::vector<WT>& dist)
+{
+	for (size_t v = 0; v < m_size; ++v)
+		m_table[v * m_stride + column] = dist[v];
+}
+
+template<class WT>
+inline void LandmarkOracle<WT>::Clear()
+{
+	m_size = 0;
+	m_stride = 0;
+	m_directed = false;
+	std::vector<size_t>().swap(m_landmarks);
+	std::vector<WT, _AlignedAllocator<WT, CacheLineSize>>().swap(m_table);
+}
+
+template<class WT>
+inline bool LandmarkOracle<WT>::IsEmpty() const
+{
+	return m_size == 0;
+}
+
+template<class WT>
+inline size_t LandmarkOracle<WT>::GetVertexNum() const
+{
+	return m_size;
+}
+
+template<class WT>
+inline size_t LandmarkOracle<WT>::GetLandmarkNum() const
+{
+	return m_landmarks.size();
+}
+
+template<class WT>
+inline size_t LandmarkOracle<WT>::GetLandmark(size_t i) const
+{
+	return m_landmarks[i];
+}
+
+template<class WT>
+inline void LandmarkOracle<WT>::SetThreadNum(size_t threadNum)
+{
+	m_threadNum = threadNum;
+}
+
+template<class WT>
+inline size_t LandmarkOracle<WT>::GetThreadNum() const
+{
+	return m_threadNum;
+}
+
+template<class WT>
+inline WT LandmarkOracle<WT>::GetDistanceFrom(size_t i, size_t v) const
+{
+	return m_table[v * m_stride + i];
+}
+
+template<class WT>
+inline WT LandmarkOracle<WT>::GetDistanceTo(size_t i, size_t v) const
+{
+	return m_table[v * m_stride + (m_directed ? GetLandmarkNum() + i : i)];
+}
+
+template<class WT>
+inline WT LandmarkOracle<WT>::GetLowerBound(size_t v, size_t target) const
+{
+	//两端都不可达的地标不能提供信息，直接跳过；只有一端可达时说明v到达不了target
+	size_t k = GetLandmarkNum();
+	const WT* rv = m_table.data() + v * m_stride;
+	const WT* rt = m_table.data() + target * m_stride;
+	const WT* tv = m_directed ? rv + k : rv;
+	const WT* tt = m_directed ? rt + k : rt;
+	WT bound = (WT)0;
+	for (size_t i = 0; i < k; ++i)
+	{
+		if (rv[i] != (WT)Infinity)
+		{
+			if (rt[i] == (WT)Infinity) //L能到达v但到达不了t
+				return (WT)Infinity;
+			if (rt[i] > rv[i] && rt[i] - rv[i] > bound) //d(L,t)-d(L,v)
+				bound = rt[i] - rv[i];
+		}
+		if (tt[i] != (WT)Infinity)
+		{
+			if (tv[i] == (WT)Infinity) //t能到达L但v到达不了L
+				return (WT)Infinity;
+			if (tv[i] > tt[i] && tv[i] - tt[i] > bound) //d(v,L)-d(t,L)
+				bound = tv[i] - tt[i];
+		}
+	}
+	return bound;
+}
+
+template<class WT>
+inline WT LandmarkOracle<WT>::GetUpperBound(size_t v, size_t target) const
+{
+	size_t k = GetLandmarkNum();
+	const WT* rt = m_table.data() + target * m_stride;
+	const WT* tv = m_table.data() + v * m_stride + (m_directed ? k : 0);
+	WT bound = (WT)Infinity;
+	for (size_t i = 0; i < k; ++i)
+		if (tv[i] != (WT)Infinity && rt[i] != (WT)Infinity && tv[i] + rt[i] < bound) //d(v,L)+d(L,t)
+			bound = tv[i] + rt[i];
+	return bound;
+}
+
+template<class WT>
+inline typename LandmarkOracle<WT>::Heuristic LandmarkOracle<WT>::GetHeuristic(size_t target) const
+{
+	return Heuristic(*this, target);
+}
@@ -1,9 +1,15 @@
 ﻿#pragma once
 
 #include <type_traits>
+#include <functional>
 #include <vector>
+#include <queue>
+#include <limits>
+#include <utility>
+#include <algorithm>
 #include "MatrixGraph.h"
-#include "UnweightedDirectedLinkGraph.h"
+#include "ThreadPool.h"
+#include "DisjointSet.h"
 
 /*双亲表示树，简单包装了一下vector，所有操作复杂度都是O(1)，只能查找某一结点的双亲，存储和查找效率都很高，不能查找孩子和兄弟
 模板PT为顶点下标类型，只能为整形，类型越小占用的空间越小
@@ -210,152 +216,290 @@ inline void MST_Edge<PT, WT, W>::AddWeight(WT w)
 	m_totalWeight += w;
 }
 
-/*并查集，用来实现Kruskal算法*/
-class MST_SearchUnion
+/*兼容之前的名字，并查集在DisjointSet.h中*/
+typedef DisjointSet<size_t> MST_SearchUnion;
+typedef ConcurrentDisjointSet MST_ConcurrentSearchUnion;
+
+class MST
 {
 public:
 
-	inline MST_SearchUnion() = default;
-	inline MST_SearchUnion(size_t size);
-	inline MST_SearchUnion(const MST_SearchUnion&) = delete;
-	inline MST_SearchUnion(MST_SearchUnion&&) = default;
-	inline ~MST_SearchUnion();
+	/*邻接表图等非邻接矩阵图的MST算法
+	Auto：按密度自动选择，稠密图用DensePrim，否则用FilterKruskal
+	Kruskal：对所有边排序后依次合并 O(EdgeNum*log(EdgeNum))
+	Prim：二叉堆优化的Prim O(EdgeNum*log(VertexNum))
+	DensePrim：逐行扫描的Prim，不需要堆，内层循环可以被编译器向量化 O(VertexNum^2+EdgeNum)
+	Boruvka：多线程Boruvka，使用硬件线程数，图不连通时返回最小生成森林 O(EdgeNum*log(VertexNum)/线程数)
+	FilterKruskal：按枢轴划分边，只对较轻的部分排序，较重的部分先过滤掉连通分量内部的边，使用硬件线程数并行排序 期望O(EdgeNum+VertexNum*log(VertexNum)*log(EdgeNum/VertexNum))*/
+	enum class Strategy
+	{
+		Auto,
+		Kruskal,
+		Prim,
+		DensePrim,
+		Boruvka,
+		FilterKruskal
+	};
 
-	/*从0--size-1*/
-	inline void Init(size_t size);
+	/*邻接表图的边数不少于可能的边数(无向图VertexNum*(VertexNum-1)/2，有向图VertexNum*(VertexNum-1))的DenseFraction时
+	Auto选择DensePrim，否则每行的填充与扫描比FilterKruskal更慢*/
+	static constexpr double DenseFraction = 0.25;
 
-	/*合并*/
-	inline void Unite(size_t x, size_t y);
+	/*采用Prim算法，WT为权重和类型(默认double)，PT为下标存储类型(默认size_t)
+	每收录一个顶点，直接扫描它在矩阵中连续存储的一行，无分支地更新并求最小值，内层循环可以被编译器向量化(建议开启-O3) 复杂度O(VertexNum^2)*/
+	template<class WT = double, class PT = size_t, class _1, class _2>
+	static MST_Parent<PT, WT> GetMST(const MatrixGraph<_1, _2>& g);
 
-	/*多调用这个函数效率会更快哦*/
-	inline size_t  FindRoot(size_t x);
+	/*用于邻接表图以及CSRGraph等非邻接矩阵图，按密度自动选择算法，WT为权重和类型(默认double)，PT为下标存储类型(默认size_t)*/
+	template<class WT = double, class PT = size_t, class _1, class _2>
+	static MST_Edge<PT, WT, _2> GetMST(const GraphBase<_1, _2>& g);
 
-	inline bool Same(size_t x, size_t y);
+	/*用指定的算法计算MST，结果为边集，图不连通时返回空(Boruvka返回最小生成森林)*/
+	template<class WT = double, class PT = size_t, class _1, class _2>
+	static MST_Edge<PT, WT, _2> GetMST(const GraphBase<_1, _2>& g, Strategy strategy);
+
+	/*采用Kruskal算法 复杂度O(EdgeNum*log(EdgeNum))*/
+	template<class WT = double, class PT = size_t, class _1, class _2>
+	static MST_Edge<PT, WT, _2> GetKruskalMST(const GraphBase<_1, _2>& g);
 
-	inline void Clear();
+	/*采用二叉堆优化的Prim算法，适合稀疏的邻接表图 复杂度O(EdgeNum*log(VertexNum))*/
+	template<class WT = double, class PT = size_t, class _1, class _2>
+	static MST_Edge<PT, WT, _2> GetPrimMST(const GraphBase<_1, _2>& g);
+
+	/*采用逐行扫描的Prim算法，适合稠密图，每收录一个顶点填充它的一行(邻接矩阵图直接读取，其它图遍历邻接点) 复杂度O(VertexNum^2+EdgeNum)*/
+	template<class WT = double, class PT = size_t, class _1, class _2>
+	static MST_Edge<PT, WT, _2> GetDensePrimMST(const GraphBase<_1, _2>& g);
+
+	/*采用多线程的Boruvka算法，每一轮并行地为每个连通分量找到最小的出边，再用无锁并查集合并，直到没有出边为止
+	图不连通时返回最小生成森林而不是空，threadNum为线程数，为0时使用硬件线程数 复杂度O(EdgeNum*log(VertexNum)/线程数)*/
+	template<class WT = double, class PT = size_t, class _1, class _2>
+	static MST_Edge<PT, WT, _2> GetBoruvkaMSF(const GraphBase<_1, _2>& g, size_t threadNum = 0);
+
+	/*采用Filter-Kruskal算法，边取出到一个数组中(不需要堆)，按枢轴分为较轻和较重两部分，先递归处理较轻的部分，
+	再过滤掉较重部分中两端已经连通的边后递归处理，边数较少时用多线程归并排序后直接合并，生成树完成时立即停止
+	threadNum为线程数，为0时使用硬件线程数 期望O(EdgeNum+VertexNum*log(VertexNum)*log(EdgeNum/VertexNum))*/
+	template<class WT = double, class PT = size_t, class _1, class _2>
+	static MST_Edge<PT, WT, _2> GetFilterKruskalMST(const GraphBase<_1, _2>& g, size_t threadNum = 0);
 
 private:
-	size_t* m_data = nullptr;
+	MST() = delete;
+
+	/*并行算法中每个任务处理的顶点数或边数*/
+	static constexpr size_t ParallelChunk = 4096;
+
+	/*边数不超过FilterKruskalRatio*VertexNum时Filter-Kruskal不再划分，直接排序*/
+	static constexpr size_t FilterKruskalRatio = 2;
+
+	/*并行算法中使用的边*/
+	template<class PT, class W>
+	struct _EdgeData
+	{
+		PT v1, v2;
+		W weight;
+	};
+
+	/*按顶点分块并行取出所有边，每条无向边只保留v1<v2的方向，自环没有意义 O(EdgeNum/线程数)*/
+	template<class PT, class _1, class W>
+	static std::vector<_EdgeData<PT, W>> CollectEdges(const GraphBase<_1, W>& g, ThreadPool& pool);
+
+	/*按权重的多线程归并排序，每个线程先排序一段，再两两归并，buffer为归并用的临时空间 O(n*log(n)/线程数+n)*/
+	template<class E>
+	static void ParallelSort(E* first, E* last, std::vector<E>& buffer, ThreadPool& pool);
+
+	/*Filter-Kruskal的递归部分，remain为生成树还差的边数，为0时返回true*/
+	template<class E, class IT, class F>
+	static bool FilterKruskal(E* first, E* last, size_t threshold, DisjointSet<IT>& su, std::vector<E>& buffer, ThreadPool& pool, size_t& remain, F& func);
+
+	/*WT的无穷大，没有无穷大的类型使用最大值*/
+	template<class WT>
+	static constexpr WT Infinity();
+
+	/*第一个没有被标记删除的顶点，没有时返回VertexNum*/
+	template<class _1, class _2>
+	static size_t FirstVertex(const GraphBase<_1, _2>& g);
+
+	/*用新收录顶点u的一段行row(0表示没有边)更新对应的len个key与parent
+	已收录的顶点key为lowest，任何边都不会比它小，不需要额外的标记数组，循环没有分支，可以被编译器向量化 O(len)*/
+	template<class WT, class PT, class X>
+	static void DenseRelax(const X* row, PT u, size_t len, WT* key, PT* parent);
+
+	/*key最小的未收录顶点，没有可以收录的顶点时返回num，循环没有分支 O(num)*/
+	template<class WT>
+	static size_t DenseMin(const WT* key, size_t num);
+
+	/*用邻接矩阵图中u的一行更新key与parent：连续存储的部分直接扫描，对角矩阵的其余列按列读取，不支持直接访问的图逐个调用GetWeight读入row O(VertexNum)*/
+	template<class WT, class PT, class _1, class W>
+	static void MatrixRelax(const MatrixGraph<_1, W>& g, size_t u, WT* key, PT* parent, std::vector<WT>& row);
+
+	/*稠密Prim，relax(u, key, parent)用新收录顶点u的一行更新key与parent，每收录一个顶点调用func(vertex, parent, weight)
+	返回收录的顶点数，被标记删除的顶点不会被收录*/
+	template<class WT, class PT, class _1, class _2, class R, class F>
+	static size_t DensePrim(const GraphBase<_1, _2>& g, R relax, F func);
 };
-inline MST_SearchUnion::MST_SearchUnion(size_t size)
-{
-	Init(size);
-}
-inline MST_SearchUnion::~MST_SearchUnion()
+
+template<class WT>
+inline constexpr WT MST::Infinity()
 {
-	Clear();
+	return std::numeric_limits<WT>::has_infinity ? std::numeric_limits<WT>::infinity() : std::numeric_limits<WT>::max();
 }
-inline void MST_SearchUnion::Init(size_t size)
+
+template<class _1, class _2>
+inline size_t MST::FirstVertex(const GraphBase<_1, _2>& g)
 {
-	Clear();
-	m_data = new unsigned[size];
-	for (unsigned i = 0; i < size; ++i)
-		m_data[i] = i;
+	size_t v = 0;
+	while (v < g.GetVertexNum() && g.IsVertexRemoved(v))
+		++v;
+	return v;
 }
-inline void MST_SearchUnion::Unite(size_t x, size_t y)
-{
-	unsigned x_root = FindRoot(x);
-	unsigned y_root = FindRoot(y);
-
-	if (x_root == y_root)
-		return;
 
-	if (x_root > y_root)
-		m_data[x] = m_data[x_root] = y_root;
-	else
-		m_data[y] = m_data[y_root] = x_root;
-}
-inline size_t  MST_SearchUnion::FindRoot(size_t x)
+template<class WT, class PT, class X>
+inline void MST::DenseRelax(const X* row, PT u, size_t len, WT* key, PT* parent)
 {
-	unsigned fd = x;
-	while (m_data[fd] != fd)
-		fd = m_data[fd];
-	return m_data[x] = fd;
+	for (size_t i = 0; i < len; ++i)
+	{
+		WT k = key[i], w = (WT)row[i];
+		bool less = (row[i] != 0) & (w < k); //用&避免短路求值产生分支
+		key[i] = less ? w : k;
+		parent[i] = less ? u : parent[i];
+	}
 }
-inline bool MST_SearchUnion::Same(size_t x, size_t y)
+
+template<class WT>
+inline size_t MST::DenseMin(const WT* key, size_t num)
 {
-	return FindRoot(x) == FindRoot(y);
+	const WT inf = Infinity<WT>(), done = std::numeric_limits<WT>::lowest();
+	WT minKey = inf;
+	for (size_t i = 0; i < num; ++i) //最小值归约，浮点数需要-ffast-math才能向量化
+	{
+		WT k = key[i] == done ? inf : key[i];
+		minKey = k < minKey ? k : minKey;
+	}
+	if (!(minKey < inf))
+		return num;
+	size_t i = 0;
+	while (key[i] != minKey)
+		++i;
+	return i;
 }
-inline void MST_SearchUnion::Clear()
+
+template<class WT, class PT, class _1, class W>
+inline void MST::MatrixRelax(const MatrixGraph<_1, W>& g, size_t u, WT* key, PT* parent, std::vector<WT>& row)
 {
-	if (m_data != nullptr)
-		delete[] m_data;
-	m_data = nullptr;
+	const size_t num = g.GetVertexNum();
+	size_t len;
+	const W* data = g.GetRowData(u, len);
+	if (!data) //不能直接访问存储
+	{
+		for (size_t i = 0; i < num; ++i)
+			row[i] = (WT)g.GetWeight(u, i);
+		DenseRelax(row.data(), (PT)u, num, key, parent);
+		return;
+	}
+	DenseRelax(data, (PT)u, len, key, parent);
+	//对角矩阵的第j列位于data[j*(j+1)/2-u*(u+1)/2+u]，相邻两列相差j+1
+	for (size_t j = len, offset = len + u; j < num; offset += ++j)
+	{
+		WT k = key[j], w = (WT)data[offset];
+		bool less = (data[offset] != 0) & (w < k);
+		key[j] = less ? w : k;
+		parent[j] = less ? (PT)u : parent[j];
+	}
 }
 
-class MST
+template<class WT, class PT, class _1, class _2, class R, class F>
+inline size_t MST::DensePrim(const GraphBase<_1, _2>& g, R relax, F func)
 {
-public:
-
-	/*采用Prim算法，WT为权重和类型(默认double)，PT为下标存储类型(默认size_t) 复杂度O(VertexNum^2)*/
-	template<class WT = double, class PT = size_t, class _1, class _2>
-	static MST_Parent<PT, WT> GetMST(const MatrixGraph<_1, _2>& g);
-
-	/*采用Kruskal算法，WT为权重和类型(默认double)，PT为下标存储类型(默认size_t) 复杂度O(EdgeNum*log(EdgeNum))*/
-	template<class WT = double, class PT = size_t, class _1, class _2, class _3>
-	static MST_Edge<PT, WT, _3> GetMST(const UnweightedDirectedLinkGraph<_1, _2, _3>& g);
-
-private:
-	MST() = delete;
-};
+	const size_t num = g.GetVertexNum();
+	const WT done = std::numeric_limits<WT>::lowest();
+	std::vector<WT> key(num, Infinity<WT>());
+	std::vector<PT> parent(num, 0);
+	for (size_t i = 0; i < num; ++i)
+		if (g.IsVertexRemoved(i))
+			key[i] = done;
+	size_t start = FirstVertex(g), count = 1;
+	key[start] = done;
+	for (size_t u = start;; ++count)
+	{
+		relax(u, key.data(), parent.data());
+		size_t v = DenseMin(key.data(), num);
+		if (v == num) //剩下的顶点都不可达
+			break;
+		func(v, parent[v], key[v]);
+		key[v] = done;
+		u = v;
+	}
+	return count;
+}
 
 template<class WT, class PT, class _1, class _2>
 MST_Parent<PT, WT> MST::GetMST(const MatrixGraph<_1, _2>& g)
 {
-	struct Distance
-	{
-		PT vertex;	//与哪个点相连
-		WT minCost = 0;  //用0标记没有被访问过
-		bool isAdded = false;	//受否被收录
-	};
-	size_t lastVertexNum = g.GetVertexNum();	 //剩余多少个顶点不在生成树中
-	Distance* dist = new Distance[g.GetVertexNum()]; //到各个顶点的距离
-	PT minEdgePos = 0;	//最小边的下标
-	PT newVertex = 0;		//新加入的顶点
-	WT tmpWeight;				//临时变量
+	const size_t num = g.GetVertexNum();
+	size_t vertexNum = num - g.GetRemovedVertexNum();	//被标记删除的顶点不算
 	MST_Parent<PT, WT> mst;		//最小生成树
 
-	if (g.IsDirected()) //不支持有向图
+	if (g.IsDirected() || vertexNum == 0) //不支持有向图
 		return mst;
 
-	mst.SetVertexNum(g.GetVertexNum()); //初始化生成树
-	if (lastVertexNum)
+	std::vector<WT> row; //不能直接访问存储时新收录顶点的一行，被标记删除的顶点所在的行列都是0
+
+	mst.SetVertexNum(num); //初始化生成树
+	mst.SetParent(FirstVertex(g), num);
+	size_t len;
+	if (!g.GetRowData(0, len))
+		row.resize(num);
+	size_t count = DensePrim<WT, PT>(g,
+		[&](size_t u, WT* key, PT* parent)
+		{
+			MatrixRelax(g, u, key, parent, row);
+		},
+		[&](size_t v, PT parent, WT w)
+		{
+			mst.SetParent(v, parent);
+			mst.AddWeight(w);
+		});
+	if (count < vertexNum) //还有剩余顶点，算法失败
+		mst.Clear();
+	return mst;
+}
+
+template<class WT, class PT, class _1, class W>
+MST_Edge<PT, WT, W> MST::GetMST(const GraphBase<_1, W>& g)
+{
+	return GetMST<WT, PT>(g, Strategy::Auto);
+}
+
+template<class WT, class PT, class _1, class W>
+MST_Edge<PT, WT, W> MST::GetMST(const GraphBase<_1, W>& g, Strategy strategy)
+{
+	if (strategy == Strategy::Auto)
 	{
-		mst.SetParent(0, g.GetVertexNum());
-		dist[0].isAdded = true;
+		double v = (double)(g.GetVertexNum() - g.GetRemovedVertexNum());
+		double e = (double)g.GetEdgeNum();
+		double possible = g.IsDirected() ? v * (v - 1) : v * (v - 1) / 2; //GetEdgeNum中每条无向边只算一次
+		//邻接矩阵图遍历邻接点本来就是O(VertexNum)的，总是逐行扫描
+		if (g.IsMatrix() || e >= DenseFraction * possible)
+			strategy = Strategy::DensePrim;
+		else
+			strategy = Strategy::FilterKruskal;
 	}
-	while (lastVertexNum--) //直到所有顶点都进入生成树为止
+	switch (strategy)
 	{
-		for (PT i = 0; i < g.GetVertexNum(); ++i) //遍历所有顶点记录并求出最小边
-		{
-			if (newVertex == i || dist[i].isAdded) //跳过自己和被添加过的顶点
-				continue;
-			tmpWeight = g.GetWeight(newVertex, i);
-			//如果没有边则跳过该点，否则如果这个点没有被访问过或者权值比原来的小则更新最小权值
-			if (tmpWeight != 0 && (dist[i].minCost == 0 || tmpWeight < dist[i].minCost))
-			{
-				dist[i].vertex = newVertex;
-				dist[i].minCost = tmpWeight;
-			}
-			//判断这个节点本省需不需要更新最小权值边，如果这个节点本身无意义就不需要更新
-			if (dist[i].minCost != 0 && (dist[minEdgePos].isAdded || dist[i].minCost < dist[minEdgePos].minCost))
-				minEdgePos = i;
-		}
-		/*如果算出来的最小权边无法到达该节点，或者这个边对应的节点被添加过了，就可以认为没有节点符合要求了*/
-		if (dist[minEdgePos].minCost == 0 || dist[minEdgePos].isAdded)
-			break;
-		//否则收录该顶点
-		mst.SetParent(minEdgePos, dist[minEdgePos].vertex);
-		dist[minEdgePos].isAdded = true;
-		newVertex = minEdgePos;
-		mst.AddWeight(dist[minEdgePos].minCost);
+	case Strategy::Kruskal:
+		return GetKruskalMST<WT, PT>(g);
+	case Strategy::DensePrim:
+		return GetDensePrimMST<WT, PT>(g);
+	case Strategy::Boruvka:
+		return GetBoruvkaMSF<WT, PT>(g);
+	case Strategy::FilterKruskal:
+		return GetFilterKruskalMST<WT, PT>(g);
+	default:
+		return GetPrimMST<WT, PT>(g);
 	}
-	if (lastVertexNum) //还有剩余顶点，算法失败
-		mst.Clear();
-	return mst;
 }
-template<class WT, class PT, class _1, class _2, class W>
-MST_Edge<PT, WT, W> MST::GetMST(const UnweightedDirectedLinkGraph<_1, _2, W>& g)
+
+template<class WT, class PT, class _1, class W>
+MST_Edge<PT, WT, W> MST::GetKruskalMST(const GraphBase<_1, W>& g)
 {
 	struct _Edge
 	{
@@ -371,31 +515,369 @@ MST_Edge<PT, WT, W> MST::GetMST(const UnweightedDirectedLinkGraph<_1, _2, W>& g)
 		}
 	};
 
-	MST_SearchUnion su(g.GetVertexNum());
+	DisjointSet<typename std::make_unsigned<PT>::type> su(g.GetVertexNum()); //与PT使用相同的下标类型
 	std::priority_queue<_Edge, std::vector<_Edge>, std::greater<_Edge>> minHeap; //最小堆
 	MST_Edge<PT, WT, W> mst;
+	size_t vertexNum = g.GetVertexNum() - g.GetRemovedVertexNum(); //被标记删除的顶点不算
 
-	if (g.IsDirected()) //不支持有向图
+	if (g.IsDirected() || vertexNum == 0) //不支持有向图
 		return mst;
 
-	mst.SetEdgeNum(g.GetVertexNum() - 1);//初始化生成树
+	mst.SetEdgeNum(vertexNum - 1);//初始化生成树
 	g.ForeachEdge([&](auto v1, auto v2, auto w)
 		{
 			minHeap.emplace(v1, v2, w);
 		}); //遍历所有边并将所有边压入堆中
 
-	while (!minHeap.empty() && mst.GetEdgeNum() < g.GetVertexNum() - 1)
+	while (!minHeap.empty() && mst.GetEdgeNum() < vertexNum - 1)
 	{
 		auto e = minHeap.top();
-		if (!su.Same(e.v1, e.v2)) //判断v1与v2是否构成回路
+		if (su.Unite(e.v1, e.v2)) //v1与v2不构成回路时合并两个子树
 		{
 			mst.AddEdge(e.v1, e.v2, e.weight);
-			su.Unite(e.v1, e.v2); //合并两个子树
 			mst.AddWeight(e.weight); //累加权重
 		}
 		minHeap.pop(); //删除该边
 	}
-	if (mst.GetEdgeNum() < g.GetVertexNum() - 1) //算法失败
+	if (mst.GetEdgeNum() < vertexNum - 1) //算法失败
+		mst.Clear();
+	return mst;
+}
+
+template<class WT, class PT, class _1, class W>
+MST_Edge<PT, WT, W> MST::GetPrimMST(const GraphBase<_1, W>& g)
+{
+	typedef std::pair<W, size_t> _HeapNode; //到生成树的最小边权，顶点
+
+	const size_t num = g.GetVertexNum();
+	size_t vertexNum = num - g.GetRemovedVertexNum(); //被标记删除的顶点不算
+	MST_Edge<PT, WT, W> mst;
+
+	if (g.IsDirected() || vertexNum == 0) //不支持有向图
+		return mst;
+
+	std::vector<W> key(num);
+	std::vector<PT> parent(num);
+	std::vector<char> state(num, 0); //0未访问，1在堆中，2已收录
+	std::priority_queue<_HeapNode, std::vector<_HeapNode>, std::greater<_HeapNode>> minHeap; //惰性删除的最小堆
+	size_t start = FirstVertex(g);
+
+	mst.SetEdgeNum(vertexNum - 1); //初始化生成树
+	state[start] = 2;
+	for (size_t u = start, count = 1;; ++count)
+	{
+		g.ForeachOutNeighbor(u, [&](auto /*from*/, auto to, auto w)
+			{
+				if (state[to] == 2 || (state[to] == 1 && !(w < key[to])))
+					return;
+				state[to] = 1;
+				key[to] = w;
+				parent[to] = (PT)u;
+				minHeap.emplace(w, to);
+			});
+		while (!minHeap.empty() && (state[minHeap.top().second] == 2 || key[minHeap.top().second] < minHeap.top().first))
+			minHeap.pop(); //跳过已收录的顶点和过期的节点
+		if (minHeap.empty())
+		{
+			if (count < vertexNum) //图不连通，算法失败
+				mst.Clear();
+			break;
+		}
+		u = minHeap.top().second;
+		minHeap.pop();
+		state[u] = 2;
+		mst.AddEdge(parent[u], (PT)u, key[u]);
+		mst.AddWeight(key[u]);
+	}
+	return mst;
+}
+
+template<class WT, class PT, class _1, class W>
+MST_Edge<PT, WT, W> MST::GetDensePrimMST(const GraphBase<_1, W>& g)
+{
+	const size_t num = g.GetVertexNum();
+	size_t vertexNum = num - g.GetRemovedVertexNum(); //被标记删除的顶点不算
+	MST_Edge<PT, WT, W> mst;
+
+	if (g.IsDirected() || vertexNum == 0) //不支持有向图
+		return mst;
+
+	auto onAdd = [&](size_t v, PT parent, WT w)
+	{
+		mst.AddEdge(parent, (PT)v, (W)w);
+		mst.AddWeight(w);
+	};
+
+	mst.SetEdgeNum(vertexNum - 1); //初始化生成树
+	std::vector<WT> row(num); //新收录顶点的一行
+	size_t count;
+	if (g.IsMatrix()) //邻接矩阵图都继承自MatrixGraph，可以直接扫描存储
+	{
+		const auto& mg = static_cast<const MatrixGraph<_1, W>&>(g);
+		count = DensePrim<WT, PT>(g, [&](size_t u, WT* key, PT* parent)
+			{
+				MatrixRelax(mg, u, key, parent, row);
+			}, onAdd);
+	}
+	else
+	{
+		count = DensePrim<WT, PT>(g, [&](size_t u, WT* key, PT* parent)
+			{
+				std::fill(row.begin(), row.end(), (WT)0);
+				g.ForeachOutNeighbor(u, [&](auto /*from*/, auto to, auto w)
+					{
+						WT weight = g.IsWeighted() ? (WT)w : (WT)1;
+						if (row[to] == 0 || weight < row[to]) //重边取最小的
+							row[to] = weight;
+					});
+				DenseRelax(row.data(), (PT)u, num, key, parent);
+			}, onAdd);
+	}
+	if (count < vertexNum) //图不连通，算法失败
 		mst.Clear();
 	return mst;
 }
+
+template<class WT, class PT, class _1, class W>
+MST_Edge<PT, WT, W> MST::GetBoruvkaMSF(const GraphBase<_1, W>& g, size_t threadNum)
+{
+	const size_t num = g.GetVertexNum();
+	const size_t npos = (size_t)-1;
+	const size_t chunk = ParallelChunk;
+	size_t vertexNum = num - g.GetRemovedVertexNum(); //被标记删除的顶点不算
+	MST_Edge<PT, WT, W> mst;
+
+	if (g.IsDirected() || vertexNum == 0) //不支持有向图
+		return mst;
+
+	ThreadPool pool(threadNum);
+	auto taskNum = [&](size_t n) { return (n + chunk - 1) / chunk; };
+
+	auto edges = CollectEdges<size_t>(g, pool);
+	decltype(edges) buffer;
+
+	ConcurrentDisjointSet su(num);
+	std::vector<std::atomic<size_t>> best(num);	//每个连通分量(以根表示)最小出边的下标
+	std::vector<char> keep;						//边的两端是否在不同的连通分量中
+	std::vector<std::vector<size_t>> chosen(pool.GetThreadNum());	//每个线程本轮合并时用到的边
+	std::vector<size_t> roots;
+	for (size_t i = 0; i < num; ++i)
+		if (!g.IsVertexRemoved(i))
+			roots.push_back(i);
+	//权重相同时按下标比较，所有连通分量使用同一个全序，选出的边不会成环
+	auto less = [&](size_t a, size_t b)
+	{
+		return edges[a].weight < edges[b].weight || (!(edges[b].weight < edges[a].weight) && a < b);
+	};
+	auto updateBest = [&](std::atomic<size_t>& slot, size_t e)
+	{
+		size_t cur = slot.load(std::memory_order_relaxed);
+		while ((cur == npos || less(e, cur)) && !slot.compare_exchange_weak(cur, e, std::memory_order_relaxed));
+	};
+
+	mst.SetEdgeNum(vertexNum - 1); //初始化生成森林
+	while (!edges.empty())
+	{
+		//第一步：每个连通分量的最小出边
+		pool.Run(taskNum(roots.size()), [&](size_t task, size_t /*thread*/)
+			{
+				size_t end = std::min(roots.size(), (task + 1) * chunk);
+				for (size_t i = task * chunk; i < end; ++i)
+					best[roots[i]].store(npos, std::memory_order_relaxed);
+			});
+		keep.assign(edges.size(), 0);
+		pool.Run(taskNum(edges.size()), [&](size_t task, size_t /*thread*/)
+			{
+				size_t end = std::min(edges.size(), (task + 1) * chunk);
+				for (size_t i = task * chunk; i < end; ++i)
+				{
+					size_t r1 = su.FindRoot(edges[i].v1), r2 = su.FindRoot(edges[i].v2);
+					if (r1 == r2)
+						continue;
+					keep[i] = 1;
+					updateBest(best[r1], i);
+					updateBest(best[r2], i);
+				}
+			});
+
+		//第二步：沿最小出边合并，两个连通分量选了同一条边时只有一次合并成功
+		pool.Run(taskNum(roots.size()), [&](size_t task, size_t thread)
+			{
+				size_t end = std::min(roots.size(), (task + 1) * chunk);
+				for (size_t i = task * chunk; i < end; ++i)
+				{
+					size_t e = best[roots[i]].load(std::memory_order_relaxed);
+					if (e != npos && su.Unite(edges[e].v1, edges[e].v2))
+						chosen[thread].push_back(e);
+				}
+			});
+		bool merged = false;
+		for (auto& part : chosen)
+		{
+			for (auto e : part)
+			{
+				mst.AddEdge((PT)edges[e].v1, (PT)edges[e].v2, edges[e].weight);
+				mst.AddWeight(edges[e].weight);
+			}
+			merged = merged || !part.empty();
+			part.clear();
+		}
+		if (!merged) //没有出边了，剩下的都是连通分量内部的边
+			break;
+
+		//第三步：删除连通分量内部的边和不再是根的顶点，本轮刚合并的边留到下一轮删除
+		std::vector<size_t> count(taskNum(edges.size()) + 1, 0);
+		pool.Run(count.size() - 1, [&](size_t task, size_t /*thread*/)
+			{
+				size_t end = std::min(edges.size(), (task + 1) * chunk);
+				for (size_t i = task * chunk; i < end; ++i)
+					count[task + 1] += keep[i];
+			});
+		for (size_t i = 1; i < count.size(); ++i)
+			count[i] += count[i - 1];
+		buffer.resize(count.back());
+		pool.Run(count.size() - 1, [&](size_t task, size_t /*thread*/)
+			{
+				size_t end = std::min(edges.size(), (task + 1) * chunk), pos = count[task];
+				for (size_t i = task * chunk; i < end; ++i)
+					if (keep[i])
+						buffer[pos++] = edges[i];
+			});
+		edges.swap(buffer);
+		roots.erase(std::remove_if(roots.begin(), roots.end(), [&](size_t v) { return su.FindRoot(v) != v; }), roots.end());
+	}
+	return mst;
+}
+
+template<class WT, class PT, class _1, class W>
+MST_Edge<PT, WT, W> MST::GetFilterKruskalMST(const GraphBase<_1, W>& g, size_t threadNum)
+{
+	typedef typename std::make_unsigned<PT>::type IT;
+
+	size_t vertexNum = g.GetVertexNum() - g.GetRemovedVertexNum(); //被标记删除的顶点不算
+	MST_Edge<PT, WT, W> mst;
+
+	if (g.IsDirected() || vertexNum == 0) //不支持有向图
+		return mst;
+
+	ThreadPool pool(threadNum);
+	auto edges = CollectEdges<PT>(g, pool);
+	decltype(edges) buffer;
+	DisjointSet<IT> su(g.GetVertexNum());
+	size_t remain = vertexNum - 1;
+	auto func = [&](const _EdgeData<PT, W>& e)
+	{
+		mst.AddEdge(e.v1, e.v2, e.weight);
+		mst.AddWeight(e.weight);
+	};
+
+	mst.SetEdgeNum(vertexNum - 1); //初始化生成树
+	if (remain)
+		FilterKruskal(edges.data(), edges.data() + edges.size(), FilterKruskalRatio * vertexNum, su, buffer, pool, remain, func);
+	if (remain) //图不连通，算法失败
+		mst.Clear();
+	return mst;
+}
+
+template<class PT, class _1, class W>
+inline std::vector<MST::_EdgeData<PT, W>> MST::CollectEdges(const GraphBase<_1, W>& g, ThreadPool& pool)
+{
+	const size_t num = g.GetVertexNum();
+	std::vector<std::vector<_EdgeData<PT, W>>> parts((num + ParallelChunk - 1) / ParallelChunk);
+	pool.Run(parts.size(), [&](size_t task, size_t /*thread*/)
+		{
+			size_t end = std::min(num, (task + 1) * ParallelChunk);
+			for (size_t u = task * ParallelChunk; u < end; ++u)
+				g.ForeachOutNeighbor(u, [&](auto /*from*/, auto to, auto w)
+					{
+						if ((size_t)to > u)
+							parts[task].push_back({ (PT)u, (PT)to, w });
+					});
+		});
+	std::vector<size_t> offset(parts.size() + 1, 0);
+	for (size_t i = 0; i < parts.size(); ++i)
+		offset[i + 1] = offset[i] + parts[i].size();
+	std::vector<_EdgeData<PT, W>> edges(offset.back());
+	pool.Run(parts.size(), [&](size_t task, size_t /*thread*/)
+		{
+			std::copy(parts[task].begin(), parts[task].end(), edges.begin() + offset[task]);
+			std::vector<_EdgeData<PT, W>>().swap(parts[task]);
+		});
+	return edges;
+}
+
+template<class E>
+inline void MST::ParallelSort(E* first, E* last, std::vector<E>& buffer, ThreadPool& pool)
+{
+	auto cmp = [](const E& a, const E& b) { return a.weight < b.weight; };
+	const size_t n = last - first;
+	const size_t parts = std::min(pool.GetThreadNum(), n / ParallelChunk);
+	if (parts <= 1)
+	{
+		std::sort(first, last, cmp);
+		return;
+	}
+	std::vector<size_t> bound(parts + 1);
+	for (size_t i = 0; i <= parts; ++i)
+		bound[i] = n * i / parts;
+	pool.Run(parts, [&](size_t task, size_t /*thread*/)
+		{
+			std::sort(first + bound[task], first + bound[task + 1], cmp);
+		});
+	if (buffer.size() < n)
+		buffer.resize(n);
+	E* src = first, * dst = buffer.data();
+	for (size_t width = 1; width < parts; width *= 2) //每轮把相邻的两段归并为一段
+	{
+		pool.Run((parts + 2 * width - 1) / (2 * width), [&](size_t task, size_t /*thread*/)
+			{
+				size_t l = task * 2 * width, m = std::min(l + width, parts), r = std::min(l + 2 * width, parts);
+				std::merge(src + bound[l], src + bound[m], src + bound[m], src + bound[r], dst + bound[l], cmp);
+			});
+		std::swap(src, dst);
+	}
+	if (src != first)
+		std::copy(src, src + n, first);
+}
+
+template<class E, class IT, class F>
+inline bool MST::FilterKruskal(E* first, E* last, size_t threshold, DisjointSet<IT>& su, std::vector<E>& buffer, ThreadPool& pool, size_t& remain, F& func)
+{
+	auto kruskal = [&](E* begin, E* end)
+	{
+		for (; begin != end; ++begin)
+		{
+			if (!su.Unite(begin->v1, begin->v2))
+				continue;
+			func(*begin);
+			if (--remain == 0)
+				return true;
+		}
+		return false;
+	};
+	auto filter = [&](E* begin, E* end)
+	{
+		return std::remove_if(begin, end, [&](const E& e) { return su.Same(e.v1, e.v2); });
+	};
+
+	if ((size_t)(last - first) <= threshold)
+	{
+		ParallelSort(first, last, buffer, pool);
+		return kruskal(first, last);
+	}
+	//取均匀分布的9个样本的中位数作为枢轴，分为小于、等于、大于枢轴三部分，等于的部分不为空，所以一定会缩小
+	const size_t n = last - first;
+	E sample[9];
+	for (size_t i = 0; i < 9; ++i)
+		sample[i] = first[n * i / 9];
+	std::nth_element(sample, sample + 4, sample + 9, [](const E& a, const E& b) { return a.weight < b.weight; });
+	auto pivot = sample[4].weight;
+	E* mid1 = std::partition(first, last, [&](const E& e) { return e.weight < pivot; });
+	E* mid2 = std::partition(mid1, last, [&](const E& e) { return !(pivot < e.weight); });
+
+	if (FilterKruskal(first, mid1, threshold, su, buffer, pool, remain, func))
+		return true;
+	if (kruskal(mid1, filter(mid1, mid2))) //权重相同，不需要排序
+		return true;
+	return FilterKruskal(mid2, filter(mid2, last), threshold, su, buffer, pool, remain, func);
+}
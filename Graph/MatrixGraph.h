@@ -40,6 +40,10 @@ public:
 
 	virtual constexpr bool IsMatrix()const override;
 
+	/*直接访问v的一行存储，供逐行扫描的算法(如MST)使用，每行只需要调用一次，不支持时(如位矩阵)返回nullptr
+	返回第0列的指针，len为从第0列开始连续存储的列数：邻接矩阵为VertexNum；对角矩阵为v+1，之后的列j位于[j*(j+1)/2-v*(v+1)/2+v]*/
+	virtual const W* GetRowData(VertexPosType v, size_t& len)const;
+
 };
 
 template<class T, class W>
@@ -98,6 +102,13 @@ inline void MatrixGraph<T, W>::ForeachInNeighbor(VertexPosType v, OnPassEdge fun
 			func(i, v, this->GetWeight(i, v));
 }
 
+template<class T, class W>
+inline const W* MatrixGraph<T, W>::GetRowData(VertexPosType /*v*/, size_t& len) const
+{
+	len = 0;
+	return nullptr;
+}
+
 template<class T, class W>
 inline constexpr bool MatrixGraph<T, W>::IsMatrix() const
 {
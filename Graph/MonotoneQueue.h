@@ -0,0 +1,211 @@
+﻿#pragma once
+
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+
+/*单调优先队列，用于非负整数权重的dijkstra，弹出的key单调不减，所以压入的key不能小于最后一次弹出的key
+两种队列的接口相同：
+	void Push(K key, V value)	//压入
+	std::pair<K, V> Pop()		//弹出key最小的元素，队列不能为空
+	bool IsEmpty()const
+	size_t GetSize()const
+	void Clear()*/
+
+/*基数堆，按key与最后弹出的key的最高不同位分桶，每个元素最多被重新分桶sizeof(K)*8次
+Push O(1)，Pop 均摊O(log(C))，C为最大权重，与元素个数无关
+K为整型，实际按无符号数比较，所以不能压入负数*/
+template<class K, class V>
+class RadixHeap
+{
+public:
+
+	static_assert(std::is_integral<K>::value, "类型K必须为整型");
+
+	/*压入，key不能小于最后一次弹出的key O(1)*/
+	void Push(K key, V value);
+
+	/*弹出key最小的元素，相同的key弹出顺序不确定 均摊O(log(C))*/
+	std::pair<K, V> Pop();
+
+	/*是否为空 O(1)*/
+	bool IsEmpty()const;
+
+	/*元素个数 O(1)*/
+	size_t GetSize()const;
+
+	/*清除所有元素，最后弹出的key重置为0*/
+	void Clear();
+
+private:
+
+	using KeyType = typename std::make_unsigned<K>::type;
+
+	static constexpr size_t BucketNum = sizeof(KeyType) * 8 + 1;
+
+	std::vector<std::pair<KeyType, V>> m_buckets[BucketNum];	//第i个桶中key与m_last的最高不同位为i-1，第0个桶中key等于m_last
+	KeyType m_last = 0;
+	size_t m_size = 0;
+
+	/*key应该放入的桶*/
+	size_t GetBucket(KeyType key)const;
+};
+
+/*Dial桶队列，环形数组中的每个桶对应一个key，当前key到最大key的跨度不超过最大权重，所以maxWeight+1个桶就够了
+Push O(1)，Pop 均摊O(1+C/VertexNum)，C为最大权重，适合最大权重较小的图
+K为整型，不能压入负数*/
+template<class K, class V>
+class BucketQueue
+{
+public:
+
+	static_assert(std::is_integral<K>::value, "类型K必须为整型");
+
+	/*maxWeight为最大权重，即同时在队列中的key的最大差值*/
+	explicit BucketQueue(size_t maxWeight);
+
+	/*压入，key不能小于最后一次弹出的key，也不能超过最后一次弹出的key+maxWeight O(1)*/
+	void Push(K key, V value);
+
+	/*弹出key最小的元素 均摊O(1+C/VertexNum)*/
+	std::pair<K, V> Pop();
+
+	/*是否为空 O(1)*/
+	bool IsEmpty()const;
+
+	/*元素个数 O(1)*/
+	size_t GetSize()const;
+
+	/*清除所有元素，最后弹出的key重置为0*/
+	void Clear();
+
+private:
+
+	std::vector<std::vector<V>> m_buckets;	//key对应第key%桶数个桶
+	K m_cur = 0;	//当前最小的key
+	size_t m_size = 0;
+};
+
+template<class K, class V>
+inline void RadixHeap<K, V>::Push(K key, V value)
+{
+	m_buckets[GetBucket((KeyType)key)].emplace_back((KeyType)key, std::move(value));
+	++m_size;
+}
+
+template<class K, class V>
+inline std::pair<K, V> RadixHeap<K, V>::Pop()
+{
+	if (m_buckets[0].empty())
+	{
+		//找到第一个非空的桶，以其中最小的key为新的m_last，重新分桶后都会落到更小的桶中
+		size_t i = 1;
+		while (m_buckets[i].empty())
+			++i;
+		auto& bucket = m_buckets[i];
+		KeyType last = bucket.front().first;
+		for (auto& e : bucket)
+			if (e.first < last)
+				last = e.first;
+		m_last = last;
+		for (auto& e : bucket)
+			m_buckets[GetBucket(e.first)].push_back(std::move(e));
+		bucket.clear();
+	}
+	auto& bucket = m_buckets[0];
+	std::pair<K, V> top((K)bucket.back().first, std::move(bucket.back().second));
+	bucket.pop_back();
+	--m_size;
+	return top;
+}
+
+template<class K, class V>
+inline bool RadixHeap<K, V>::IsEmpty() const
+{
+	return m_size == 0;
+}
+
+template<class K, class V>
+inline size_t RadixHeap<K, V>::GetSize() const
+{
+	return m_size;
+}
+
+template<class K, class V>
+inline void RadixHeap<K, V>::Clear()
+{
+	for (auto& bucket : m_buckets)
+		bucket.clear();
+	m_last = 0;
+	m_size = 0;
+}
+
+template<class K, class V>
+inline size_t RadixHeap<K, V>::GetBucket(KeyType key) const
+{
+	KeyType diff = key ^ m_last;
+	if (diff == 0)
+		return 0;
+#if defined(__GNUC__) || defined(__clang__)
+	if (sizeof(KeyType) <= sizeof(unsigned long long))
+		return (size_t)(64 - __builtin_clzll((unsigned long long)diff));
+#endif
+	size_t i = 0;
+	while (diff)
+	{
+		diff >>= 1;
+		++i;
+	}
+	return i;
+}
+
+template<class K, class V>
+inline BucketQueue<K, V>::BucketQueue(size_t maxWeight) :
+	m_buckets(maxWeight + 1)
+{
+}
+
+template<class K, class V>
+inline void BucketQueue<K, V>::Push(K key, V value)
+{
+	m_buckets[(size_t)key % m_buckets.size()].push_back(std::move(value));
+	++m_size;
+}
+
+template<class K, class V>
+inline std::pair<K, V> BucketQueue<K, V>::Pop()
+{
+	size_t i = (size_t)m_cur % m_buckets.size();
+	while (m_buckets[i].empty())
+	{
+		++m_cur;
+		if (++i == m_buckets.size())
+			i = 0;
+	}
+	std::pair<K, V> top(m_cur, std::move(m_buckets[i].back()));
+	m_buckets[i].pop_back();
+	--m_size;
+	return top;
+}
+
+template<class K, class V>
+inline bool BucketQueue<K, V>::IsEmpty() const
+{
+	return m_size == 0;
+}
+
+template<class K, class V>
+inline size_t BucketQueue<K, V>::GetSize() const
+{
+	return m_size;
+}
+
+template<class K, class V>
+inline void BucketQueue<K, V>::Clear()
+{
+	for (auto& bucket : m_buckets)
+		bucket.clear();
+	m_cur = 0;
+	m_size = 0;
+}
@@ -4,7 +4,16 @@
 #include <functional>
 #include <vector>
 #include <stack>
+#include <deque>
+#include <queue>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <limits>
 #include "GraphBase.h"
+#include "ThreadPool.h"
+#include "MonotoneQueue.h"
 
 /*WT是权重累加和类型，一般是一个比较大的类型*/
 template<class WT>
@@ -23,10 +32,21 @@ public:
 
 	static constexpr auto NullValue = static_cast<WT>(-1);
 
-	/*执行sssp，根据图的类型不同，选择dijkstra还是bfs改造算法，权重为负数的图会导致算法出错*/
+	/*WT与W都是整型时，最大权重不超过这个值就使用Dial桶队列，否则使用基数堆*/
+	static constexpr size_t DialMaxWeight = 1024;
+
+	/*执行sssp，根据图的类型不同，选择dijkstra还是bfs改造算法，权重为负数的图会导致算法出错
+	有权图使用二叉堆优化的dijkstra O((VertexNum+EdgeNum)*log(EdgeNum))，无权图 O(VertexNum+EdgeNum)
+	WT与W都是整型时改用单调队列去掉log：先遍历一次所有边求最大权重C，C为1时等价于无权图(权重0表示没有边，所以0-1权重的图就是无权图)，直接bfs
+	C不超过DialMaxWeight时使用Dial桶队列 O(EdgeNum+VertexNum*C)，否则使用基数堆 O(EdgeNum+VertexNum*log(C))*/
 	template<class T, class W>
 	void Execute(const GraphBase<T, W>& g, size_t src);
 
+	/*点对点查询，target被收录后立即停止，只保证src到target的距离与路径正确，其他顶点的结果可能不是最短的
+	最坏情况与@Execute(g, src)相同，target离src越近越快*/
+	template<class T, class W>
+	void Execute(const GraphBase<T, W>& g, size_t src, size_t target);
+
 	/*顶点数量 O(1)*/
 	size_t GetVertexNum()const;
 
@@ -45,7 +65,7 @@ public:
 	/*遍历到某节点的最短路径 O(Path)*/
 	void ForeachPath(size_t target, std::function<void(size_t)> func)const;
 
-private:
+protected:
 
 	size_t m_src;
 	std::vector<_VertexInfo> m_info;
@@ -53,13 +73,21 @@ private:
 	/*初始化顶点，dist全初始化为 NullValue，prev全是num*/
 	void Init(size_t num, size_t src);
 
-	/*获取单源最短路径，BFS改进算法*/
+	/*获取单源最短路径，BFS改进算法，target被访问到时停止，target为NPOS时遍历整个连通分量*/
 	template<class T, class W>
-	void UnweightedSSSP(const GraphBase<T, W>& g, size_t src);
+	void UnweightedSSSP(const GraphBase<T, W>& g, size_t src, size_t target);
 
-	/*获取单源最短路径，使用dijkstra算法*/
+	/*获取单源最短路径，使用二叉堆优化的dijkstra算法，target被收录时停止，target为NPOS时遍历整个连通分量*/
 	template<class T, class W>
-	void WeightedSSSP(const GraphBase<T, W>& g, size_t src);
+	void WeightedSSSP(const GraphBase<T, W>& g, size_t src, size_t target, std::false_type isIntegral);
+
+	/*整数权重的单源最短路径，根据最大权重选择bfs、Dial桶队列或者基数堆，点对点查询时不遍历所有边，直接使用基数堆*/
+	template<class T, class W>
+	void WeightedSSSP(const GraphBase<T, W>& g, size_t src, size_t target, std::true_type isIntegral);
+
+	/*使用单调队列q的dijkstra算法，q需要提供Push(dist, pos)/Pop()/IsEmpty()*/
+	template<class T, class W, class Q>
+	void MonotoneSSSP(const GraphBase<T, W>& g, size_t src, size_t target, Q& q);
 };
 
 /*权重为非负整数的SSSP*/
@@ -120,8 +148,7 @@ inline void SSSP<WT>::ForeachPath(size_t target, std::function<void(size_t)> fun
 template<class WT>
 inline void SSSP<WT>::Init(size_t num, size_t src)
 {
-	Clear();
-	m_info.resize(num, { NullValue, (size_t)num });
+	m_info.assign(num, { NullValue, (size_t)num }); //不释放内存，重复执行时复用之前的容量
 	m_src = src;
 }
 
@@ -130,20 +157,27 @@ template<class WT>
 template<class T, class W>
 inline void SSSP<WT>::Execute(const GraphBase<T, W>& g, size_t src)
 {
-	Clear();
+	Execute(g, src, (size_t)GraphBase<T, W>::NPOS);
+}
+
+template<class WT>
+template<class T, class W>
+inline void SSSP<WT>::Execute(const GraphBase<T, W>& g, size_t src, size_t target)
+{
+	m_info.clear();
 	if (!g.GetVertexNum())
 		return;
 	Init(g.GetVertexNum(), src);
 	m_info[src].dist = (WT)0;
 	if (g.IsWeighted())
-		WeightedSSSP(g, src);
+		WeightedSSSP(g, src, target, std::integral_constant<bool, std::is_integral<WT>::value && std::is_integral<W>::value>());
 	else
-		UnweightedSSSP(g, src);
+		UnweightedSSSP(g, src, target);
 }
 
 template<class WT>
 template<class T, class W>
-inline void SSSP<WT>::UnweightedSSSP(const GraphBase<T, W>& g, size_t src)
+inline void SSSP<WT>::UnweightedSSSP(const GraphBase<T, W>& g, size_t src, size_t target)
 {
 	std::queue<size_t> q;
 
@@ -153,6 +187,8 @@ inline void SSSP<WT>::UnweightedSSSP(const GraphBase<T, W>& g, size_t src)
 	{
 		auto pos = q.front();
 		q.pop();
+		if (pos == target) //目标已经出队，距离不会再变了
+			break;
 		g.ForeachOutNeighbor(pos, [&](auto i) //遍历所有邻接点
 			{
 				if (m_info[i].dist == NullValue)
@@ -167,213 +203,1781 @@ inline void SSSP<WT>::UnweightedSSSP(const GraphBase<T, W>& g, size_t src)
 
 template<class WT>
 template<class T, class W>
-inline void SSSP<WT>::WeightedSSSP(const GraphBase<T, W>& g, size_t src)
+inline void SSSP<WT>::WeightedSSSP(const GraphBase<T, W>& g, size_t src, size_t target, std::false_type /*isIntegral*/)
 {
-	struct _VertexInfo //查找未收录顶点需要用到
+	struct _HeapNode //堆中的顶点，同一个顶点可能有多个，只有距离最小的那个有效
 	{
-		size_t pos;
 		WT dist;
+		size_t pos;
 
-		_VertexInfo(size_t pos, WT dist) :
-			pos(pos), dist(dist) {}
-		bool operator<(const _VertexInfo& v)const
+		_HeapNode(WT dist, size_t pos) :
+			dist(dist), pos(pos) {}
+		bool operator>(const _HeapNode& v)const
 		{
-			if (dist == v.dist)
-				return pos > v.pos;
-			if (dist < 0)
-				return true;
-			else if (v.dist < 0)
-				return false;
 			return dist > v.dist;
 		}
 	};
 
 	std::vector<bool> collected(GetVertexNum(), false); //判断是否收录过，因为并不是像bfs一样每个顶点遍历一次，所以需要记录
-	size_t unClNum = GetVertexNum(); //未收录顶点个数
+	std::priority_queue<_HeapNode, std::vector<_HeapNode>, std::greater<_HeapNode>> pq; //最小堆，整个算法只用这一个
+
+	/*距离变小时不修改堆中的旧节点，而是直接压入新节点，旧节点弹出时顶点已经被收录，直接跳过即可
+	每条边最多压入一次，所以堆的大小不超过EdgeNum O((VertexNum+EdgeNum)*log(EdgeNum))*/
+	pq.emplace((WT)0, src);
+	while (!pq.empty())
+	{
+		_HeapNode top = pq.top();
+		pq.pop();
+		if (collected[top.pos]) //过期的节点
+			continue;
+		collected[top.pos] = true;
+		if (top.pos == target) //目标已经收录，距离不会再变了
+			break;
+		g.ForeachOutNeighbor(top.pos, [&](auto /*from*/, auto to, auto w) //遍历所有邻接点
+			{
+				if (collected[to]) //已经收录
+					return;
+				WT dist = top.dist + (WT)w;
+				if (m_info[to].dist == NullValue || dist < m_info[to].dist) //如果没访问过或者距离可以更新
+				{
+					m_info[to].dist = dist;
+					m_info[to].prevVertex = top.pos;
+					pq.emplace(dist, to);
+				}
+			});
+	}
+}
 
-	/*初始化顶点*/
-	collected[src] = true;
+template<class WT>
+template<class T, class W>
+inline void SSSP<WT>::WeightedSSSP(const GraphBase<T, W>& g, size_t src, size_t target, std::true_type /*isIntegral*/)
+{
+	if (target != GraphBase<T, W>::NPOS) //点对点查询可能很快结束，不值得遍历所有边
+	{
+		RadixHeap<WT, size_t> q;
+		MonotoneSSSP(g, src, target, q);
+		return;
+	}
 
-	g.ForeachOutNeighbor(src, [&](auto from, auto to, auto w) //遍历所有邻接点
+	WT maxWeight = (WT)0;
+	g.ForeachEdge([&](auto /*from*/, auto /*to*/, auto w)
 		{
-			m_info[to].dist = w;
-			m_info[to].prevVertex = from;
+			if ((WT)w > maxWeight)
+				maxWeight = (WT)w;
 		});
-
-	while (--unClNum)
+	if (maxWeight <= (WT)1) //所有边的权重都是1
+		UnweightedSSSP(g, src, target);
+	else if (maxWeight <= (WT)DialMaxWeight)
+	{
+		BucketQueue<WT, size_t> q((size_t)maxWeight);
+		MonotoneSSSP(g, src, target, q);
+	}
+	else
 	{
-		std::priority_queue<_VertexInfo> pq;//最小堆，用来找最小未收录顶点
-		/*查找一个最小收录顶点*/
-		for (size_t i = 0; i < collected.size(); ++i)
-			if (!collected[i] && m_info[i].dist > 0)
-				pq.emplace(i, m_info[i].dist);
+		RadixHeap<WT, size_t> q;
+		MonotoneSSSP(g, src, target, q);
+	}
+}
 
-		if (pq.empty()) //如果没有联通的点，就退出
-			break;
+template<class WT>
+template<class T, class W, class Q>
+inline void SSSP<WT>::MonotoneSSSP(const GraphBase<T, W>& g, size_t src, size_t target, Q& q)
+{
+	std::vector<bool> collected(GetVertexNum(), false);
 
-		collected[pq.top().pos] = true;
-		g.ForeachOutNeighbor(pq.top().pos, [&](auto i, auto j, auto w) //遍历所有邻接点
+	//与二叉堆版本相同，采用惰性删除，过期的节点弹出时跳过
+	q.Push((WT)0, src);
+	while (!q.IsEmpty())
+	{
+		auto top = q.Pop();
+		if (collected[top.second])
+			continue;
+		collected[top.second] = true;
+		if (top.second == target)
+			break;
+		g.ForeachOutNeighbor(top.second, [&](auto /*from*/, auto to, auto w)
 			{
-				if (!collected[j]) //如果没收录
-					if (m_info[j].dist < 0 || m_info[i].dist + w < m_info[j].dist) //如果没访问过或者距离可以更新
-					{
-						m_info[j].dist = m_info[i].dist + w;
-						m_info[j].prevVertex = i;
-					}
+				if (collected[to])
+					return;
+				WT dist = top.first + (WT)w;
+				if (m_info[to].dist == NullValue || dist < m_info[to].dist)
+				{
+					m_info[to].dist = dist;
+					m_info[to].prevVertex = top.second;
+					q.Push(dist, to);
+				}
 			});
 	}
 }
-/*WT是权重累加和类型，一般是一个比较大的类型*/
+
+/*双向点对点最短路径，同时从src沿出边、从target沿入边搜索，两边相遇后停止，通常只需要访问单向搜索的一小部分顶点
+有权图使用双向dijkstra，无权图使用按层交替的双向bfs，每次扩展较小的一边
+有向图的反向搜索依赖ForeachInNeighbor，请使用开启入边索引的邻接表图、有序数组邻接表图或者CSRGraph，否则反向搜索每次都要遍历所有边
+WT是权重累加和类型，一般是一个比较大的类型*/
 template<class WT>
-class MSSP
+class BidirectionalSSSP
 {
 	struct _VertexInfo
 	{
 		WT dist;
-		size_t prevVertex;
+		size_t prevVertex;	//正向搜索中为路径上的前驱，反向搜索中为路径上的后继
 	};
 public:
 
 	static_assert(std::is_arithmetic<WT>::value, "类型WT必须为算数类型");
-	static_assert(std::is_integral<size_t>::value, "类型size_t必须为整型");
-	static_assert(sizeof(size_t) <= sizeof(size_t), "类型size_t太大了，不需要这么大");
 
 	static constexpr auto NullValue = static_cast<WT>(-1);
 
-	/*执行MSSP，使用Floyd算法，权重为负数的图会导致算法出错 O(VertexNum^3)*/
+	/*执行src到target的点对点查询，权重为负数的图会导致算法出错*/
 	template<class T, class W>
-	void Execute(const GraphBase<T, W>& g);
-
-	/*顶点数量 O(1)*/
-	size_t GetVertexNum()const;
+	void Execute(const GraphBase<T, W>& g, size_t src, size_t target);
 
 	/*清除*/
 	void Clear();
 
-	/*是否为空O(1)*/
+	/*是否为空 O(1)*/
 	bool IsEmpty()const;
 
-	/*获取到某节点的最短距离，如果target!=src但是返回值为0，说明此路不通 O(1)*/
-	WT GetDistance(size_t src, size_t target)const;
+	/*获取源点 O(1)*/
+	size_t GetSrc()const;
 
-	/*遍历从某节点到某节点的最短路径 O(Path)*/
-	void ForeachPath(size_t src, size_t target, std::function<void(size_t)> func)const;
+	/*获取终点 O(1)*/
+	size_t GetTarget()const;
+
+	/*获取src到target的最短距离，不连通时返回NullValue O(1)*/
+	WT GetDistance()const;
+
+	/*从src到target遍历最短路径，不连通时不会调用func O(Path)*/
+	void ForeachPath(std::function<void(size_t)> func)const;
 
 private:
 
-	size_t m_size = 0;
-	std::vector<_VertexInfo> m_info;
+	size_t m_src = 0;
+	size_t m_target = 0;
+	size_t m_meet = 0;					//两边搜索的相遇点
+	WT m_dist = NullValue;
+	std::vector<_VertexInfo> m_info[2];	//0为正向搜索，1为反向搜索
 
 	/*初始化顶点，dist全初始化为 NullValue，prev全是num*/
-	void Init(size_t num);
+	void Init(size_t num, size_t src, size_t target);
 
-	_VertexInfo& GetInfo(size_t from, size_t to);
+	/*遍历dir方向的邻接点，func(邻接点, 权重) 反向搜索在有向图中遍历入邻接点*/
+	template<class T, class W, class F>
+	static void ForeachNeighbor(const GraphBase<T, W>& g, size_t dir, size_t v, F func);
 
-	const _VertexInfo& GetInfo(size_t from, size_t to)const;
+	/*x被dir方向访问到后，如果另一边也访问过x，则尝试用经过x的路径更新结果*/
+	void TryMeet(size_t dir, size_t x);
+
+	/*双向bfs*/
+	template<class T, class W>
+	void UnweightedSearch(const GraphBase<T, W>& g);
 
+	/*双向dijkstra，两个堆顶的距离之和不小于已知最短距离时停止*/
+	template<class T, class W>
+	void WeightedSearch(const GraphBase<T, W>& g);
 };
 
-/*权重为非负整数的MSSP*/
-typedef MSSP<unsigned long long> IntegerMSSP;
-/*权重为非负小数的MSSP*/
-typedef MSSP<double> DecimalMSSP;
+/*权重为非负整数的双向点对点最短路径*/
+typedef BidirectionalSSSP<unsigned long long> IntegerBidirectionalSSSP;
+/*权重为非负小数的双向点对点最短路径*/
+typedef BidirectionalSSSP<double> DecimalBidirectionalSSSP;
 
 template<class WT>
-inline size_t MSSP<WT>::GetVertexNum() const
+template<class T, class W>
+inline void BidirectionalSSSP<WT>::Execute(const GraphBase<T, W>& g, size_t src, size_t target)
 {
-	return m_size;
+	Clear();
+	if (!g.GetVertexNum())
+		return;
+	Init(g.GetVertexNum(), src, target);
+	if (src == target)
+	{
+		m_dist = (WT)0;
+		m_meet = src;
+		return;
+	}
+	if (g.IsWeighted())
+		WeightedSearch(g);
+	else
+		UnweightedSearch(g);
 }
 
 template<class WT>
-inline void MSSP<WT>::Clear()
+inline void BidirectionalSSSP<WT>::Clear()
 {
-	m_info.clear();
-	m_info.shrink_to_fit();
-	m_size = 0;
+	for (auto& i : m_info)
+	{
+		i.clear();
+		i.shrink_to_fit();
+	}
+	m_dist = NullValue;
 }
 
 template<class WT>
-inline bool MSSP<WT>::IsEmpty() const
+inline bool BidirectionalSSSP<WT>::IsEmpty() const
 {
-	return m_size == 0;
+	return m_info[0].empty();
 }
 
 template<class WT>
-inline WT MSSP<WT>::GetDistance(size_t src, size_t target) const
+inline size_t BidirectionalSSSP<WT>::GetSrc() const
 {
-	return m_info[src * m_size + target].dist;
+	return m_src;
 }
 
 template<class WT>
-inline void MSSP<WT>::ForeachPath(size_t src, size_t target, std::function<void(size_t)> func) const
+inline size_t BidirectionalSSSP<WT>::GetTarget() const
 {
-	if (GetDistance(src, target) == NullValue) //此路不通
+	return m_target;
+}
+
+template<class WT>
+inline WT BidirectionalSSSP<WT>::GetDistance() const
+{
+	return m_dist;
+}
+
+template<class WT>
+inline void BidirectionalSSSP<WT>::ForeachPath(std::function<void(size_t)> func) const
+{
+	if (m_dist == NullValue)
 		return;
-	//想想，要从i->j，那么就要从i->k->j，其中k为中转点存在m_info[i][j].prevVertex里
-	//然后，要从i->k，那么就要从i->l->k，其中l为中转点.......
-	//最后，要从i->x，那么.............，然而m_info[i][x].prevVertex并没有点，说明了i->x本身就是最短路径，不需要中转点
-	//所以，从i->j，就变成了i->x->...->l->k->j，从x->...->k是个逆序过程
-	std::stack<size_t> path;
-	auto j = target;
-	size_t k;
-	while ((k = GetInfo(src, j).prevVertex) != m_size)
-	{
-		path.push(k); //经过k
-		j = k; //更新j
-	}
-	func(src);
-	while (!path.empty())
+	size_t num = m_info[0].size();
+	std::stack<size_t> stack; //相遇点到src是逆序的
+	for (size_t v = m_meet; v != num; v = m_info[0][v].prevVertex)
+		stack.push(v);
+	while (!stack.empty())
 	{
-		func(path.top());
-		path.pop();
+		func(stack.top());
+		stack.pop();
 	}
-	func(target);
+	for (size_t v = m_info[1][m_meet].prevVertex; v != num; v = m_info[1][v].prevVertex) //相遇点到target是顺序的
+		func(v);
 }
 
 template<class WT>
-inline void MSSP<WT>::Init(size_t num)
+inline void BidirectionalSSSP<WT>::Init(size_t num, size_t src, size_t target)
 {
-	Clear();
-	m_info.resize(num * num, { NullValue, (size_t)num });
-	m_size = num;
+	for (auto& i : m_info)
+		i.resize(num, { NullValue, num });
+	m_src = src;
+	m_target = target;
+	m_info[0][src].dist = (WT)0;
+	m_info[1][target].dist = (WT)0;
+}
+
+template<class WT>
+template<class T, class W, class F>
+inline void BidirectionalSSSP<WT>::ForeachNeighbor(const GraphBase<T, W>& g, size_t dir, size_t v, F func)
+{
+	if (dir == 0 || !g.IsDirected())
+		g.ForeachOutNeighbor(v, [&](auto /*from*/, auto to, auto w)
+			{
+				func((size_t)to, w);
+			});
+	else
+		g.ForeachInNeighbor(v, [&](auto from, auto /*to*/, auto w)
+			{
+				func((size_t)from, w);
+			});
 }
 
 template<class WT>
-inline typename MSSP<WT>::_VertexInfo& MSSP<WT>::GetInfo(size_t from, size_t to)
+inline void BidirectionalSSSP<WT>::TryMeet(size_t dir, size_t x)
 {
-	return m_info[from * m_size + to];
+	if (m_info[1 - dir][x].dist == NullValue)
+		return;
+	WT dist = m_info[0][x].dist + m_info[1][x].dist;
+	if (m_dist == NullValue || dist < m_dist)
+	{
+		m_dist = dist;
+		m_meet = x;
+	}
 }
 
 template<class WT>
-inline const typename MSSP<WT>::_VertexInfo& MSSP<WT>::GetInfo(size_t from, size_t to) const
+template<class T, class W>
+inline void BidirectionalSSSP<WT>::UnweightedSearch(const GraphBase<T, W>& g)
 {
-	return m_info[from * m_size + to];
+	std::vector<size_t> frontier[2] = { { m_src }, { m_target } }, next;
+	/*每次把较小的一边扩展完整的一层，两边的已访问集合第一次相交时，这一层里找到的相遇点都在最短路径上*/
+	while (!frontier[0].empty() && !frontier[1].empty())
+	{
+		size_t dir = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+		next.clear();
+		for (auto v : frontier[dir])
+			ForeachNeighbor(g, dir, v, [&](size_t x, const W& /*w*/)
+				{
+					if (m_info[dir][x].dist != NullValue)
+						return;
+					m_info[dir][x].dist = m_info[dir][v].dist + 1;
+					m_info[dir][x].prevVertex = v;
+					next.push_back(x);
+					TryMeet(dir, x);
+				});
+		if (m_dist != NullValue)
+			return;
+		frontier[dir].swap(next);
+	}
 }
 
 template<class WT>
 template<class T, class W>
-inline void MSSP<WT>::Execute(const GraphBase<T, W>& g)
+inline void BidirectionalSSSP<WT>::WeightedSearch(const GraphBase<T, W>& g)
 {
-	Clear();
+	struct _HeapNode //堆中的顶点，同一个顶点可能有多个，只有距离最小的那个有效
+	{
+		WT dist;
+		size_t pos;
+
+		_HeapNode(WT dist, size_t pos) :
+			dist(dist), pos(pos) {}
+		bool operator>(const _HeapNode& v)const
+		{
+			return dist > v.dist;
+		}
+	};
+
+	std::vector<bool> collected[2] = { std::vector<bool>(m_info[0].size(), false), std::vector<bool>(m_info[0].size(), false) };
+	std::priority_queue<_HeapNode, std::vector<_HeapNode>, std::greater<_HeapNode>> pq[2];
+	pq[0].emplace((WT)0, m_src);
+	pq[1].emplace((WT)0, m_target);
+	while (!pq[0].empty() && !pq[1].empty())
+	{
+		//堆顶是两边未收录顶点距离的下界，任何更短的路径都必须经过两边都未收录的顶点，此时已经不可能了
+		if (m_dist != NullValue && pq[0].top().dist + pq[1].top().dist >= m_dist)
+			return;
+		size_t dir = pq[0].size() <= pq[1].size() ? 0 : 1;
+		_HeapNode top = pq[dir].top();
+		pq[dir].pop();
+		if (collected[dir][top.pos]) //过期的节点
+			continue;
+		collected[dir][top.pos] = true;
+		ForeachNeighbor(g, dir, top.pos, [&](size_t x, const W& w)
+			{
+				WT dist = top.dist + (WT)w;
+				if (m_info[dir][x].dist == NullValue || dist < m_info[dir][x].dist)
+				{
+					m_info[dir][x].dist = dist;
+					m_info[dir][x].prevVertex = top.pos;
+					pq[dir].emplace(dist, x);
+				}
+				TryMeet(dir, x);
+			});
+	}
+}
+
+/*A*点对点最短路径，在dijkstra的基础上用启发函数估计顶点到target的距离，优先扩展估计总距离最小的顶点
+启发函数H为可调用对象，H(size_t v)返回v到target距离的估计值(可转换为WT)，如按顶点坐标计算的直线距离
+启发函数必须是一致的：h(target)=0，且对每条边u->v有h(u)<=w(u,v)+h(v)，否则结果可能不是最短路径
+h(v)返回Unreachable(WT的最大值，浮点型为无穷大)表示v到达不了target，v会被剪枝，此时h(u)可以任意；h(u)为Unreachable时h(v)也必须是Unreachable
+开启一致性检查后，每次松弛边时都会检查，不满足时抛出std::logic_error，用来调试启发函数
+结果的获取方式与SSSP相同，GetDistance(target)/ForeachPath(target, func)，只保证src到target的结果正确
+WT是权重累加和类型，一般是一个比较大的类型*/
+template<class WT>
+class AStar :public SSSP<WT>
+{
+public:
+
+	using SSSP<WT>::NullValue;
+	using SSSP<WT>::Execute;
+
+	/*启发函数返回该值表示顶点到达不了target*/
+	static constexpr WT Unreachable = std::numeric_limits<WT>::has_infinity ? std::numeric_limits<WT>::infinity() : std::numeric_limits<WT>::max();
+
+	/*执行src到target的A*搜索，启发函数恒为0时退化为@SSSP::Execute(g, src, target)
+	O((VertexNum+EdgeNum)*log(EdgeNum))，实际访问的顶点数取决于启发函数的精确程度*/
+	template<class T, class W, class H>
+	void Execute(const GraphBase<T, W>& g, size_t src, size_t target, H heuristic);
+
+	/*开启或关闭一致性检查，默认关闭*/
+	void SetConsistencyCheck(bool enable);
+
+	/*是否开启了一致性检查 O(1)*/
+	bool HasConsistencyCheck()const;
+
+	/*上一次搜索收录的顶点数，可以用来评估启发函数的效果 O(1)*/
+	size_t GetSettledNum()const;
+
+private:
+
+	bool m_checkConsistency = false;
+	size_t m_settledNum = 0;
+
+	/*检查启发函数在边u->v上是否一致，不一致时抛出std::logic_error，小数允许1e-9的相对误差*/
+	void CheckConsistency(size_t u, size_t v, WT w, WT hu, WT hv)const;
+};
+
+/*权重为非负整数的A**/
+typedef AStar<unsigned long long> IntegerAStar;
+/*权重为非负小数的A**/
+typedef AStar<double> DecimalAStar;
+
+template<class WT>
+template<class T, class W, class H>
+inline void AStar<WT>::Execute(const GraphBase<T, W>& g, size_t src, size_t target, H heuristic)
+{
+	struct _HeapNode //堆中的顶点，同一个顶点可能有多个，只有估计距离最小的那个有效
+	{
+		WT estimate; //dist+h
+		size_t pos;
+
+		_HeapNode(WT estimate, size_t pos) :
+			estimate(estimate), pos(pos) {}
+		bool operator>(const _HeapNode& v)const
+		{
+			return estimate > v.estimate;
+		}
+	};
+
+	this->m_info.clear();
+	m_settledNum = 0;
 	if (!g.GetVertexNum())
 		return;
-	Init(g.GetVertexNum());
-	g.ForeachEdge([&](auto from, auto to, auto w) //初始化距离为权重大小
-		{
-			GetInfo(from, to).dist = (WT)w;
-		});
+	this->Init(g.GetVertexNum(), src);
+	this->m_info[src].dist = (WT)0;
+	if (m_checkConsistency && (WT)heuristic(target) != (WT)0)
+		throw std::logic_error("A*启发函数不一致：h(target)!=0");
 
-	for (size_t k = 0; k < m_size; ++k)
-		for (size_t i = 0; i < m_size; ++i)
-			for (size_t j = 0; j < m_size; ++j)
+	std::vector<bool> collected(this->GetVertexNum(), false);
+	std::priority_queue<_HeapNode, std::vector<_HeapNode>, std::greater<_HeapNode>> pq;
+	WT hs = (WT)heuristic(src);
+	if (hs == (WT)Unreachable)
+		return;
+	pq.emplace(hs, src);
+	while (!pq.empty())
+	{
+		size_t pos = pq.top().pos;
+		pq.pop();
+		if (collected[pos]) //过期的节点
+			continue;
+		collected[pos] = true;
+		++m_settledNum;
+		if (pos == target) //启发函数一致时，target被收录时的距离就是最短距离
+			break;
+		WT dist = this->m_info[pos].dist, h = m_checkConsistency ? (WT)heuristic(pos) : (WT)0;
+		g.ForeachOutNeighbor(pos, [&](auto /*from*/, auto to, auto w) //遍历所有邻接点
 			{
-				//如果i->k或者k->j不存在通路，那么i->j就不可能经过k有最短路径
-				if (GetInfo(i, k).dist == NullValue || GetInfo(k, j).dist == NullValue)
-					continue;
-				if (GetInfo(i, k).dist + GetInfo(k, j).dist < GetInfo(i, j).dist)
+				WT weight = g.IsWeighted() ? (WT)w : (WT)1;
+				if (m_checkConsistency)
+					CheckConsistency(pos, to, weight, h, (WT)heuristic(to));
+				if (collected[to])
+					return;
+				if (this->m_info[to].dist == NullValue || dist + weight < this->m_info[to].dist)
 				{
-					GetInfo(i, j).dist = GetInfo(i, k).dist + GetInfo(k, j).dist;
-					GetInfo(i, j).prevVertex = k;
+					WT hv = (WT)heuristic(to);
+					if (hv == (WT)Unreachable) //to到达不了target，剪枝
+						return;
+					this->m_info[to].dist = dist + weight;
+					this->m_info[to].prevVertex = pos;
+					pq.emplace(dist + weight + hv, to);
 				}
+			});
+	}
+}
+
+template<class WT>
+inline void AStar<WT>::SetConsistencyCheck(bool enable)
+{
+	m_checkConsistency = enable;
+}
+
+template<class WT>
+inline bool AStar<WT>::HasConsistencyCheck() const
+{
+	return m_checkConsistency;
+}
+
+template<class WT>
+inline size_t AStar<WT>::GetSettledNum() const
+{
+	return m_settledNum;
+}
+
+template<class WT>
+inline void AStar<WT>::CheckConsistency(size_t u, size_t v, WT w, WT hu, WT hv) const
+{
+	if (hv == (WT)Unreachable) //v到达不了target，对h(u)没有限制
+		return;
+	if (hu == (WT)Unreachable)
+		throw std::logic_error("A*启发函数不一致：存在边u->v使h(u)为Unreachable而h(v)不是，u=" + std::to_string(u) + "，v=" + std::to_string(v));
+	WT bound = w + hv;
+	if (std::is_floating_point<WT>::value) //小数允许一点舍入误差，如直线距离
+		bound += (bound < (WT)1 ? (WT)1 : bound) * (WT)1e-9;
+	if (hu > bound)
+		throw std::logic_error("A*启发函数不一致：存在边u->v使h(u)>w(u,v)+h(v)，u=" + std::to_string(u) + "，v=" + std::to_string(v));
+}
+
+/*并行delta-stepping单源最短路径，结果的获取方式与SSSP相同，距离与SSSP完全一致(相同距离的路径可能不同)
+按距离把顶点分到宽度为delta的桶中，从小到大处理每个桶，同一个桶中的顶点并行松弛：
+	轻边(w<=delta)可能把顶点放回当前桶，需要反复处理直到当前桶为空；重边(w>delta)只需要在当前桶处理完后松弛一次
+每轮松弛分两步：各线程遍历自己分到的顶点，按终点所在的分区生成松弛请求；再由每个线程处理属于自己分区的请求，所以不需要锁和原子操作
+delta越小越接近dijkstra(并行度低)，越大越接近bellman-ford(重复松弛多)，为0时自动选择 最大权重*VertexNum/EdgeNum
+并行遍历时会在多个线程中同时调用图的ForeachOutNeighbor，不要在执行期间修改图
+WT是权重累加和类型，一般是一个比较大的类型*/
+template<class WT>
+class DeltaSSSP :public SSSP<WT>
+{
+public:
+
+	using SSSP<WT>::NullValue;
+
+	/*threadNum为线程数，为0时使用硬件线程数，delta为桶宽，为0时自动选择*/
+	explicit DeltaSSSP(size_t threadNum = 0, WT delta = 0);
+
+	/*执行sssp，权重为负数的图会导致算法出错，无权图的每条边视为1*/
+	template<class T, class W>
+	void Execute(const GraphBase<T, W>& g, size_t src);
+
+	/*设置桶宽，为0时自动选择*/
+	void SetDelta(WT delta);
+
+	/*获取设置的桶宽 O(1)*/
+	WT GetDelta()const;
+
+	/*获取线程数 O(1)*/
+	size_t GetThreadNum()const;
+
+private:
+
+	/*松弛请求，由生成请求的线程按终点分区存放*/
+	struct _Request
+	{
+		size_t vertex;
+		size_t prevVertex;
+		WT dist;
+	};
+
+	WT m_delta;
+	ThreadPool m_pool;
+	std::vector<std::vector<_Request>> m_requests;	//[生成请求的线程*线程数+终点分区]
+
+	/*并行松弛frontier中顶点的出边，isLight为true时只松弛轻边，否则只松弛重边，距离变小的顶点按桶号放入updated*/
+	template<class T, class W>
+	void Relax(const GraphBase<T, W>& g, const std::vector<size_t>& frontier, bool isLight, WT delta,
+		std::vector<std::vector<std::pair<size_t, size_t>>>& updated);
+};
+
+/*权重为非负整数的并行SSSP*/
+typedef DeltaSSSP<unsigned long long> IntegerDeltaSSSP;
+/*权重为非负小数的并行SSSP*/
+typedef DeltaSSSP<double> DecimalDeltaSSSP;
+
+template<class WT>
+inline DeltaSSSP<WT>::DeltaSSSP(size_t threadNum, WT delta) :
+	m_delta(delta), m_pool(threadNum)
+{
+}
+
+template<class WT>
+template<class T, class W>
+inline void DeltaSSSP<WT>::Execute(const GraphBase<T, W>& g, size_t src)
+{
+	this->m_info.clear();
+	if (!g.GetVertexNum())
+		return;
+	this->Init(g.GetVertexNum(), src);
+	this->m_info[src].dist = (WT)0;
+
+	WT delta = m_delta;
+	if (delta == (WT)0) //自动选择：最大权重/平均度数
+	{
+		WT maxWeight = (WT)1;
+		if (g.IsWeighted())
+			g.ForeachEdge([&](auto /*from*/, auto /*to*/, auto w)
+				{
+					if ((WT)w > maxWeight)
+						maxWeight = (WT)w;
+				});
+		size_t edgeNum = g.IsDirected() ? g.GetEdgeNum() : g.GetEdgeNum() * 2;
+		delta = edgeNum == 0 ? maxWeight : maxWeight * (WT)g.GetVertexNum() / (WT)edgeNum;
+		if (delta < (WT)1 && std::is_integral<WT>::value)
+			delta = (WT)1;
+		if (delta <= (WT)0)
+			delta = maxWeight;
+	}
+
+	const size_t none = this->GetVertexNum();
+	std::vector<size_t> inBucket(this->GetVertexNum(), none);	//顶点当前所在的桶，不在桶中为none
+	std::vector<bool> settled(this->GetVertexNum(), false);		//是否已经加入当前桶的已处理集合
+	std::vector<std::vector<size_t>> buckets(1, std::vector<size_t>{ src });
+	std::vector<std::vector<std::pair<size_t, size_t>>> updated(GetThreadNum()); //每个分区中距离变小的(桶号, 顶点)
+	std::vector<size_t> frontier, processed;
+	inBucket[src] = 0;
+
+	/*把updated中的顶点放入对应的桶中*/
+	auto collect = [&]()
+	{
+		for (auto& part : updated)
+		{
+			for (auto& i : part)
+			{
+				if (i.first >= buckets.size())
+					buckets.resize(i.first + 1);
+				buckets[i.first].push_back(i.second);
 			}
+			part.clear();
+		}
+	};
+
+	for (size_t b = 0; b < buckets.size(); ++b)
+	{
+		processed.clear();
+		while (!buckets[b].empty())
+		{
+			frontier.clear();
+			for (auto v : buckets[b])
+				if (inBucket[v] == b) //同一个顶点只处理一次，移到更小的桶后旧的位置就失效了
+				{
+					inBucket[v] = none;
+					frontier.push_back(v);
+					if (!settled[v])
+					{
+						settled[v] = true;
+						processed.push_back(v);
+					}
+				}
+			buckets[b].clear();
+			Relax(g, frontier, true, delta, updated);
+			for (auto& part : updated) //Relax中无法知道顶点之前在哪个桶，在这里统一修正
+				for (auto& i : part)
+					inBucket[i.second] = i.first;
+			collect();
+		}
+		Relax(g, processed, false, delta, updated); //重边不会把顶点放回当前桶
+		for (auto& part : updated)
+			for (auto& i : part)
+				inBucket[i.second] = i.first;
+		collect();
+		for (auto v : processed)
+			settled[v] = false;
+		std::vector<size_t>().swap(buckets[b]);
+	}
+}
+
+template<class WT>
+inline void DeltaSSSP<WT>::SetDelta(WT delta)
+{
+	m_delta = delta;
+}
+
+template<class WT>
+inline WT DeltaSSSP<WT>::GetDelta() const
+{
+	return m_delta;
+}
+
+template<class WT>
+inline size_t DeltaSSSP<WT>::GetThreadNum() const
+{
+	return m_pool.GetThreadNum();
+}
+
+template<class WT>
+template<class T, class W>
+inline void DeltaSSSP<WT>::Relax(const GraphBase<T, W>& g, const std::vector<size_t>& frontier, bool isLight, WT delta,
+	std::vector<std::vector<std::pair<size_t, size_t>>>& updated)
+{
+	size_t threadNum = GetThreadNum();
+	m_requests.resize(threadNum * threadNum);
+	const size_t chunk = 256; //每个任务处理的顶点数
+
+	//第一步：生成请求，只读取距离
+	m_pool.Run((frontier.size() + chunk - 1) / chunk, [&](size_t task, size_t thread)
+		{
+			size_t end = std::min(frontier.size(), (task + 1) * chunk);
+			for (size_t i = task * chunk; i < end; ++i)
+			{
+				size_t u = frontier[i];
+				WT dist = this->m_info[u].dist;
+				g.ForeachOutNeighbor(u, [&](auto /*from*/, auto to, auto w)
+					{
+						WT weight = g.IsWeighted() ? (WT)w : (WT)1;
+						if ((weight <= delta) != isLight)
+							return;
+						WT newDist = dist + weight;
+						WT oldDist = this->m_info[to].dist; //可能正在被别的线程读取，但这一步中没有线程写入
+						if (oldDist == NullValue || newDist < oldDist)
+							m_requests[thread * threadNum + to % threadNum].push_back({ (size_t)to, u, newDist });
+					});
+			}
+		});
+
+	//第二步：每个线程处理终点在自己分区中的请求，只有这个线程会写入这些顶点
+	m_pool.Run(threadNum, [&](size_t part, size_t /*thread*/)
+		{
+			for (size_t t = 0; t < threadNum; ++t)
+			{
+				auto& requests = m_requests[t * threadNum + part];
+				for (auto& r : requests)
+				{
+					auto& info = this->m_info[r.vertex];
+					if (info.dist == NullValue || r.dist < info.dist)
+					{
+						info.dist = r.dist;
+						info.prevVertex = r.prevVertex;
+						updated[part].emplace_back((size_t)(r.dist / delta), r.vertex);
+					}
+				}
+				requests.clear();
+			}
+		});
+}
+
+/*可以处理负权边的单源最短路径，结果的获取方式与SSSP相同
+单线程时使用队列优化的bellman-ford(SPFA)，并采用small-label-first：新入队的顶点距离比队首小时放到队首
+	每个顶点记录当前路径的边数，边数达到VertexNum的倍数时沿前驱查找环，找到即为负环，立即停止
+多线程时按轮并行松弛上一轮距离变小的顶点，松弛分为生成请求和按终点分区处理请求两步(与DeltaSSSP相同)，没有顶点变化时提前结束
+	超过VertexNum轮仍有变化时沿前驱查找负环
+存在从src可达的负环时，距离没有意义，Execute返回false，可以通过GetNegativeCycle获取环上的顶点
+WT是权重累加和类型，必须为有符号类型*/
+template<class WT>
+class SPFA :public SSSP<WT>
+{
+public:
+
+	static_assert(std::is_signed<WT>::value, "类型WT必须为有符号类型");
+
+	using SSSP<WT>::NullValue;
+
+	/*threadNum为线程数，为1时使用单线程SPFA，为0时使用硬件线程数*/
+	explicit SPFA(size_t threadNum = 1);
+
+	/*执行sssp，存在从src可达的负环时返回false 单线程最坏O(VertexNum*EdgeNum)，通常接近O(EdgeNum)*/
+	template<class T, class W>
+	bool Execute(const GraphBase<T, W>& g, size_t src);
+
+	/*设置线程数，为1时使用单线程SPFA，为0时使用硬件线程数*/
+	void SetThreadNum(size_t threadNum);
+
+	/*获取设置的线程数 O(1)*/
+	size_t GetThreadNum()const;
+
+	/*src能否到达target，有负权边时NullValue也可能是真实的距离，请用这个函数判断 O(1)*/
+	bool IsReachable(size_t target)const;
+
+	/*上一次执行是否找到了负环 O(1)*/
+	bool HasNegativeCycle()const;
+
+	/*负环上的顶点，按边的方向排列，最后一个顶点有边指向第一个顶点，没有负环时为空 O(1)*/
+	const std::vector<size_t>& GetNegativeCycle()const;
+
+private:
+
+	/*松弛请求，由生成请求的线程按终点分区存放*/
+	struct _Request
+	{
+		size_t vertex;
+		size_t prevVertex;
+		WT dist;
+	};
+
+	size_t m_threadNum;
+	std::vector<size_t> m_cycle;
+
+	/*单线程SPFA*/
+	template<class T, class W>
+	void SerialExecute(const GraphBase<T, W>& g, size_t src);
+
+	/*多线程按轮松弛*/
+	template<class T, class W>
+	void ParallelExecute(const GraphBase<T, W>& g, size_t src, ThreadPool& pool);
+
+	/*从v开始沿前驱走，前驱链中有环时把环存入m_cycle并返回true，mark与stamp用来标记本次走过的顶点 O(VertexNum)*/
+	bool FindCycle(size_t v, std::vector<size_t>& mark, size_t stamp);
+};
+
+/*权重为整数(可以为负数)的SPFA*/
+typedef SPFA<long long> IntegerSPFA;
+/*权重为小数(可以为负数)的SPFA*/
+typedef SPFA<double> DecimalSPFA;
+
+template<class WT>
+inline SPFA<WT>::SPFA(size_t threadNum) :
+	m_threadNum(threadNum)
+{
+}
+
+template<class WT>
+template<class T, class W>
+inline bool SPFA<WT>::Execute(const GraphBase<T, W>& g, size_t src)
+{
+	this->m_info.clear();
+	m_cycle.clear();
+	if (!g.GetVertexNum())
+		return true;
+	this->Init(g.GetVertexNum(), src);
+	this->m_info[src].dist = (WT)0;
+	if (m_threadNum == 1)
+		SerialExecute(g, src);
+	else
+	{
+		ThreadPool pool(m_threadNum);
+		ParallelExecute(g, src, pool);
+	}
+	return m_cycle.empty();
+}
+
+template<class WT>
+inline void SPFA<WT>::SetThreadNum(size_t threadNum)
+{
+	m_threadNum = threadNum;
+}
+
+template<class WT>
+inline size_t SPFA<WT>::GetThreadNum() const
+{
+	return m_threadNum;
+}
+
+template<class WT>
+inline bool SPFA<WT>::IsReachable(size_t target) const
+{
+	return target == this->m_src || this->m_info[target].prevVertex != this->GetVertexNum();
+}
+
+template<class WT>
+inline bool SPFA<WT>::HasNegativeCycle() const
+{
+	return !m_cycle.empty();
+}
+
+template<class WT>
+inline const std::vector<size_t>& SPFA<WT>::GetNegativeCycle() const
+{
+	return m_cycle;
+}
+
+template<class WT>
+template<class T, class W>
+inline void SPFA<WT>::SerialExecute(const GraphBase<T, W>& g, size_t src)
+{
+	const size_t num = this->GetVertexNum();
+	auto& info = this->m_info;
+	std::deque<size_t> q;
+	std::vector<bool> inQueue(num, false);
+	std::vector<size_t> length(num, 0);	//当前路径的边数
+	std::vector<size_t> mark(num, 0);
+	size_t stamp = 0;
+
+	q.push_back(src);
+	inQueue[src] = true;
+	while (!q.empty())
+	{
+		size_t u = q.front();
+		q.pop_front();
+		inQueue[u] = false;
+		bool found = false;
+		g.ForeachOutNeighbor(u, [&](auto /*from*/, auto to, auto w)
+			{
+				if (found)
+					return;
+				WT dist = info[u].dist + (g.IsWeighted() ? (WT)w : (WT)1);
+				bool reached = to == src || info[to].prevVertex != num;
+				if (reached && dist >= info[to].dist)
+					return;
+				info[to].dist = dist;
+				info[to].prevVertex = u;
+				length[to] = length[u] + 1;
+				if (length[to] % num == 0 && FindCycle(to, mark, ++stamp)) //路径太长了，可能经过了负环
+				{
+					found = true;
+					return;
+				}
+				if (!inQueue[to])
+				{
+					inQueue[to] = true;
+					if (!q.empty() && dist < info[q.front()].dist) //small-label-first
+						q.push_front(to);
+					else
+						q.push_back(to);
+				}
+			});
+		if (found)
+			return;
+	}
+}
+
+template<class WT>
+template<class T, class W>
+inline void SPFA<WT>::ParallelExecute(const GraphBase<T, W>& g, size_t src, ThreadPool& pool)
+{
+	const size_t num = this->GetVertexNum();
+	const size_t threadNum = pool.GetThreadNum();
+	const size_t chunk = 256; //每个任务处理的顶点数
+	auto& info = this->m_info;
+	std::vector<std::vector<_Request>> requests(threadNum * threadNum);	//[生成请求的线程*线程数+终点分区]
+	std::vector<std::vector<size_t>> changed(threadNum);	//每个分区中本轮距离变小的顶点
+	std::vector<char> inFrontier(num, false);	//不能用vector<bool>，不同分区的线程会写同一个字
+	std::vector<size_t> frontier{ src }, mark(num, 0);
+	size_t stamp = 0;
+
+	for (size_t round = 1; !frontier.empty(); ++round)
+	{
+		//第一步：生成请求，只读取距离
+		pool.Run((frontier.size() + chunk - 1) / chunk, [&](size_t task, size_t thread)
+			{
+				size_t end = std::min(frontier.size(), (task + 1) * chunk);
+				for (size_t i = task * chunk; i < end; ++i)
+				{
+					size_t u = frontier[i];
+					WT dist = info[u].dist;
+					g.ForeachOutNeighbor(u, [&](auto /*from*/, auto to, auto w)
+						{
+							WT newDist = dist + (g.IsWeighted() ? (WT)w : (WT)1);
+							bool reached = to == src || info[to].prevVertex != num;
+							if (!reached || newDist < info[to].dist)
+								requests[thread * threadNum + to % threadNum].push_back({ (size_t)to, u, newDist });
+						});
+				}
+			});
+
+		//第二步：每个线程处理终点在自己分区中的请求
+		pool.Run(threadNum, [&](size_t part, size_t /*thread*/)
+			{
+				for (size_t t = 0; t < threadNum; ++t)
+				{
+					for (auto& r : requests[t * threadNum + part])
+					{
+						auto& v = info[r.vertex];
+						bool reached = r.vertex == src || v.prevVertex != num;
+						if (!reached || r.dist < v.dist)
+						{
+							v.dist = r.dist;
+							v.prevVertex = r.prevVertex;
+							if (!inFrontier[r.vertex]) //每个顶点只属于一个分区，这里的写入不会冲突
+							{
+								inFrontier[r.vertex] = true;
+								changed[part].push_back(r.vertex);
+							}
+						}
+					}
+					requests[t * threadNum + part].clear();
+				}
+			});
+
+		frontier.clear();
+		for (auto& part : changed)
+		{
+			for (auto v : part)
+			{
+				inFrontier[v] = false;
+				frontier.push_back(v);
+			}
+			part.clear();
+		}
+		if (round % num == 0) //没有负环时最多num-1轮就不会再变化了
+			for (auto v : frontier)
+				if (FindCycle(v, mark, ++stamp))
+					return;
+	}
+}
+
+template<class WT>
+inline bool SPFA<WT>::FindCycle(size_t v, std::vector<size_t>& mark, size_t stamp)
+{
+	const size_t num = this->GetVertexNum();
+	auto& info = this->m_info;
+	while (v != num && mark[v] != stamp)
+	{
+		mark[v] = stamp;
+		v = info[v].prevVertex;
+	}
+	if (v == num) //走到了源点，没有环
+		return false;
+	//v在环上，沿前驱再走一圈得到逆序的环
+	m_cycle.clear();
+	size_t i = v;
+	do
+	{
+		m_cycle.push_back(i);
+		i = info[i].prevVertex;
+	} while (i != v);
+	std::reverse(m_cycle.begin(), m_cycle.end());
+	return true;
+}
+
+/*WT是权重累加和类型，一般是一个比较大的类型*/
+template<class WT>
+class MSSP
+{
+public:
+
+	static_assert(std::is_arithmetic<WT>::value, "类型WT必须为算数类型");
+	static_assert(std::is_integral<size_t>::value, "类型size_t必须为整型");
+	static_assert(sizeof(size_t) <= sizeof(size_t), "类型size_t太大了，不需要这么大");
+
+	static constexpr auto NullValue = static_cast<WT>(-1);
+
+	/*分块Floyd算法的块边长，64*64个8字节的距离为32KB，一次更新涉及的三个块可以放在L2中*/
+	static constexpr size_t BlockSize = 64;
+
+	/*threadNum为Execute使用的线程数，为0时使用硬件线程数*/
+	explicit MSSP(size_t threadNum = 0);
+
+	/*执行MSSP，使用分块Floyd算法，权重为负数的图会导致算法出错 O(VertexNum^3)
+	距离和前驱分别存放在两个数组中，按BlockSize*BlockSize的块更新：
+		每轮先更新对角块，再并行更新同一行和同一列的块，最后并行更新其余所有块，最内层循环没有分支，可以被编译器向量化*/
+	template<class T, class W>
+	void Execute(const GraphBase<T, W>& g);
+
+	/*设置Execute使用的线程数，为0时使用硬件线程数*/
+	void SetThreadNum(size_t threadNum);
+
+	/*获取设置的线程数 O(1)*/
+	size_t GetThreadNum()const;
+
+	/*顶点数量 O(1)*/
+	size_t GetVertexNum()const;
+
+	/*清除*/
+	void Clear();
+
+	/*是否为空O(1)*/
+	bool IsEmpty()const;
+
+	/*获取到某节点的最短距离，此路不通时返回NullValue，src到自身为0 O(1)*/
+	WT GetDistance(size_t src, size_t target)const;
+
+	/*遍历从某节点到某节点的最短路径 O(Path)*/
+	void ForeachPath(size_t src, size_t target, std::function<void(size_t)> func)const;
+
+private:
+
+	/*内部表示不通的距离，整型取最大值的一半，两个相加也不会溢出，并且总是不小于它自己，所以松弛时不需要判断是否不通*/
+	static constexpr WT Infinity = std::numeric_limits<WT>::has_infinity ? std::numeric_limits<WT>::infinity() : std::numeric_limits<WT>::max() / 2;
+
+	size_t m_size = 0;
+	size_t m_threadNum;
+	std::vector<WT> m_dist;			//m_dist[from*m_size+to]为from到to的最短距离
+	std::vector<size_t> m_prevVertex;	//m_prevVertex[from*m_size+to]为from到to的最短路径上to的前一个顶点，不通时为m_size
+
+	/*初始化顶点，dist全初始化为Infinity，对角线为0，prev全是num*/
+	void Init(size_t num);
+
+	/*以[k0, k1)为中转点，用行块[i0, i1)与列块[j0, j1)更新块(i, j)*/
+	void UpdateBlock(size_t i0, size_t i1, size_t j0, size_t j1, size_t k0, size_t k1);
+};
+
+/*权重为非负整数的MSSP*/
+typedef MSSP<unsigned long long> IntegerMSSP;
+/*权重为非负小数的MSSP*/
+typedef MSSP<double> DecimalMSSP;
+
+template<class WT>
+inline MSSP<WT>::MSSP(size_t threadNum) :
+	m_threadNum(threadNum)
+{
+}
+
+template<class WT>
+inline void MSSP<WT>::SetThreadNum(size_t threadNum)
+{
+	m_threadNum = threadNum;
+}
+
+template<class WT>
+inline size_t MSSP<WT>::GetThreadNum() const
+{
+	return m_threadNum;
+}
+
+template<class WT>
+inline size_t MSSP<WT>::GetVertexNum() const
+{
+	return m_size;
+}
+
+template<class WT>
+inline void MSSP<WT>::Clear()
+{
+	m_dist.clear();
+	m_dist.shrink_to_fit();
+	m_prevVertex.clear();
+	m_prevVertex.shrink_to_fit();
+	m_size = 0;
+}
+
+template<class WT>
+inline bool MSSP<WT>::IsEmpty() const
+{
+	return m_size == 0;
+}
+
+template<class WT>
+inline WT MSSP<WT>::GetDistance(size_t src, size_t target) const
+{
+	WT dist = m_dist[src * m_size + target];
+	return dist >= Infinity ? NullValue : dist;
+}
+
+template<class WT>
+inline void MSSP<WT>::ForeachPath(size_t src, size_t target, std::function<void(size_t)> func) const
+{
+	if (GetDistance(src, target) == NullValue) //此路不通
+		return;
+	//m_prevVertex[src][j]是src->j路径上j的前一个顶点，从target往回走到src，再逆序输出
+	std::stack<size_t> path;
+	for (size_t j = target; j != src; j = m_prevVertex[src * m_size + j])
+		path.push(j);
+	func(src);
+	while (!path.empty())
+	{
+		func(path.top());
+		path.pop();
+	}
+}
+
+template<class WT>
+inline void MSSP<WT>::Init(size_t num)
+{
+	Clear();
+	m_dist.resize(num * num, (WT)Infinity);
+	m_prevVertex.resize(num * num, num);
+	for (size_t i = 0; i < num; ++i)
+		m_dist[i * num + i] = (WT)0;
+	m_size = num;
+}
+
+template<class WT>
+inline void MSSP<WT>::UpdateBlock(size_t i0, size_t i1, size_t j0, size_t j1, size_t k0, size_t k1)
+{
+	for (size_t k = k0; k < k1; ++k)
+	{
+		const WT* distK = m_dist.data() + k * m_size;
+		const size_t* prevK = m_prevVertex.data() + k * m_size;
+		for (size_t i = i0; i < i1; ++i)
+		{
+			WT* distI = m_dist.data() + i * m_size;
+			size_t* prevI = m_prevVertex.data() + i * m_size;
+			const WT distIK = distI[k];
+			if (distIK >= Infinity) //整行都不会被更新
+				continue;
+			for (size_t j = j0; j < j1; ++j) //min-plus内核，写成条件选择而不是分支，便于向量化
+			{
+				WT dist = distIK + distK[j];
+				bool less = dist < distI[j];
+				distI[j] = less ? dist : distI[j];
+				prevI[j] = less ? prevK[j] : prevI[j];
+			}
+		}
+	}
+}
+
+template<class WT>
+template<class T, class W>
+inline void MSSP<WT>::Execute(const GraphBase<T, W>& g)
+{
+	Clear();
+	if (!g.GetVertexNum())
+		return;
+	Init(g.GetVertexNum());
+	auto setEdge = [&](size_t from, size_t to, WT w) //重边取最小的权重
+	{
+		if (from != to && w < m_dist[from * m_size + to])
+		{
+			m_dist[from * m_size + to] = w;
+			m_prevVertex[from * m_size + to] = from;
+		}
+	};
+	g.ForeachEdge([&](auto from, auto to, auto w) //初始化距离为权重大小
+		{
+			WT weight = g.IsWeighted() ? (WT)w : (WT)1;
+			setEdge(from, to, weight);
+			if (!g.IsDirected())
+				setEdge(to, from, weight);
+		});
+
+	size_t blockNum = (m_size + BlockSize - 1) / BlockSize;
+	auto begin = [&](size_t b) { return b * BlockSize; };
+	auto end = [&](size_t b) { return std::min(m_size, (b + 1) * BlockSize); };
+	ThreadPool pool(blockNum == 1 ? 1 : m_threadNum);
+	for (size_t kb = 0; kb < blockNum; ++kb)
+	{
+		size_t k0 = begin(kb), k1 = end(kb);
+		//第一步：对角块只依赖自己
+		UpdateBlock(k0, k1, k0, k1, k0, k1);
+		//第二步：第kb行与第kb列的块只依赖自己和对角块
+		pool.Run((blockNum - 1) * 2, [&](size_t task, size_t /*thread*/)
+			{
+				size_t b = task / 2;
+				if (b >= kb)
+					++b;
+				if (task % 2 == 0)
+					UpdateBlock(k0, k1, begin(b), end(b), k0, k1);
+				else
+					UpdateBlock(begin(b), end(b), k0, k1, k0, k1);
+			});
+		//第三步：其余的块只依赖同一行与同一列中第二步更新过的块，互相独立
+		pool.Run((blockNum - 1) * (blockNum - 1), [&](size_t task, size_t /*thread*/)
+			{
+				size_t ib = task / (blockNum - 1), jb = task % (blockNum - 1);
+				if (ib >= kb)
+					++ib;
+				if (jb >= kb)
+					++jb;
+				UpdateBlock(begin(ib), end(ib), begin(jb), end(jb), k0, k1);
+			});
+	}
+}
+
+/*稀疏图的多源最短路径，对每个源点执行一次dijkstra(无权图为bfs)，不同源点在多个线程中并行执行 O(S*(VertexNum+EdgeNum)*log(EdgeNum))，S为源点数
+有负权边时先用bellman-ford求出每个顶点的势h，把权重改为w+h(from)-h(to)(Johnson算法)，改完后所有权重非负，最后再把距离换算回来 额外O(VertexNum*EdgeNum)
+可以只计算一部分源点，结果按源点的顺序存放在紧凑的距离表中，每行VertexNum个距离
+WT是权重累加和类型，有负权边时必须为有符号类型*/
+template<class WT>
+class JohnsonMSSP
+{
+public:
+
+	static_assert(std::is_arithmetic<WT>::value, "类型WT必须为算数类型");
+
+	static constexpr auto NullValue = static_cast<WT>(-1);
+
+	/*距离表中表示不通的值，整型为最大值的一半，浮点型为无穷大*/
+	static constexpr WT Infinity = std::numeric_limits<WT>::has_infinity ? std::numeric_limits<WT>::infinity() : std::numeric_limits<WT>::max() / 2;
+
+	/*threadNum为Execute使用的线程数，为0时使用硬件线程数*/
+	explicit JohnsonMSSP(size_t threadNum = 0);
+
+	/*计算所有顶点之间的最短路径，图中存在负环(无向图中存在负权边也算)时抛出std::invalid_argument*/
+	template<class T, class W>
+	void Execute(const GraphBase<T, W>& g);
+
+	/*只计算以sources中的顶点为源点的最短路径，图中存在负环时抛出std::invalid_argument*/
+	template<class T, class W>
+	void Execute(const GraphBase<T, W>& g, const std::vector<size_t>& sources);
+
+	/*设置Execute使用的线程数，为0时使用硬件线程数*/
+	void SetThreadNum(size_t threadNum);
+
+	/*获取设置的线程数 O(1)*/
+	size_t GetThreadNum()const;
+
+	/*顶点数量 O(1)*/
+	size_t GetVertexNum()const;
+
+	/*源点数量，即距离表的行数 O(1)*/
+	size_t GetSourceNum()const;
+
+	/*距离表第i行对应的源点 O(1)*/
+	size_t GetSource(size_t i)const;
+
+	/*紧凑的距离表，第i行(i*VertexNum开始的VertexNum个元素)为第i个源点到所有顶点的距离，不通时为Infinity O(1)*/
+	const std::vector<WT>& GetDistanceTable()const;
+
+	/*清除*/
+	void Clear();
+
+	/*是否为空O(1)*/
+	bool IsEmpty()const;
+
+	/*src是否计算过 O(1)*/
+	bool IsSource(size_t src)const;
+
+	/*src能否到达target，src必须计算过 O(1)*/
+	bool IsReachable(size_t src, size_t target)const;
+
+	/*获取到某节点的最短距离，此路不通时返回NullValue，有负权边时NullValue也可能是真实的距离，请用IsReachable判断 O(1)*/
+	WT GetDistance(size_t src, size_t target)const;
+
+	/*遍历从某节点到某节点的最短路径 O(Path)*/
+	void ForeachPath(size_t src, size_t target, std::function<void(size_t)> func)const;
+
+private:
+
+	struct _Edge
+	{
+		size_t from;
+		size_t to;
+		WT weight;
+	};
+
+	size_t m_size = 0;
+	size_t m_threadNum;
+	std::vector<size_t> m_sources;		//距离表每行对应的源点
+	std::vector<size_t> m_row;			//m_row[v]为v在距离表中的行号，没有计算过为m_sources.size()
+	std::vector<WT> m_dist;				//m_dist[row*m_size+to]为第row个源点到to的最短距离
+	std::vector<size_t> m_prevVertex;	//m_prevVertex[row*m_size+to]为最短路径上to的前一个顶点，不通时为m_size
+
+	/*用bellman-ford求出每个顶点的势，没有负权边时全为0，存在负环时抛出异常 O(VertexNum*EdgeNum)*/
+	template<class T, class W>
+	std::vector<WT> GetPotential(const GraphBase<T, W>& g)const;
+};
+
+/*权重为整数(可以为负数)的稀疏图MSSP*/
+typedef JohnsonMSSP<long long> IntegerJohnsonMSSP;
+/*权重为小数(可以为负数)的稀疏图MSSP*/
+typedef JohnsonMSSP<double> DecimalJohnsonMSSP;
+
+template<class WT>
+inline JohnsonMSSP<WT>::JohnsonMSSP(size_t threadNum) :
+	m_threadNum(threadNum)
+{
+}
+
+template<class WT>
+template<class T, class W>
+inline void JohnsonMSSP<WT>::Execute(const GraphBase<T, W>& g)
+{
+	std::vector<size_t> sources(g.GetVertexNum());
+	for (size_t i = 0; i < sources.size(); ++i)
+		sources[i] = i;
+	Execute(g, sources);
+}
+
+template<class WT>
+template<class T, class W>
+inline void JohnsonMSSP<WT>::Execute(const GraphBase<T, W>& g, const std::vector<size_t>& sources)
+{
+	Clear();
+	if (!g.GetVertexNum())
+		return;
+	std::vector<WT> h = GetPotential(g);
+	size_t num = g.GetVertexNum();
+	m_size = num;
+	m_sources = sources;
+	m_row.assign(num, sources.size());
+	for (size_t i = 0; i < sources.size(); ++i)
+		m_row[sources[i]] = i;
+	m_dist.assign(sources.size() * num, (WT)Infinity);
+	m_prevVertex.assign(sources.size() * num, num);
+
+	typedef std::pair<WT, size_t> _HeapNode;
+	ThreadPool pool(sources.size() < 2 ? 1 : m_threadNum);
+	std::vector<std::vector<bool>> collected(pool.GetThreadNum());	//每个线程一份，用完后恢复为全false
+	std::vector<std::vector<size_t>> visited(pool.GetThreadNum());	//本次收录的顶点，用来恢复collected
+	std::vector<std::priority_queue<_HeapNode, std::vector<_HeapNode>, std::greater<_HeapNode>>> heaps(pool.GetThreadNum());
+
+	pool.Run(sources.size(), [&](size_t row, size_t thread)
+		{
+			size_t src = sources[row];
+			WT* dist = m_dist.data() + row * num;
+			size_t* prev = m_prevVertex.data() + row * num;
+			dist[src] = (WT)0;
+			if (!g.IsWeighted()) //无权图直接bfs
+			{
+				std::queue<size_t> q;
+				q.push(src);
+				while (!q.empty())
+				{
+					size_t pos = q.front();
+					q.pop();
+					g.ForeachOutNeighbor(pos, [&](auto i)
+						{
+							if (dist[i] == (WT)Infinity)
+							{
+								dist[i] = dist[pos] + (WT)1;
+								prev[i] = pos;
+								q.push(i);
+							}
+						});
+				}
+				return;
+			}
+
+			auto& done = collected[thread];
+			auto& list = visited[thread];
+			auto& pq = heaps[thread];
+			done.resize(num, false);
+			pq.emplace((WT)0, src);
+			while (!pq.empty()) //与SSSP相同的惰性删除dijkstra，dist中暂时存放改过权重后的距离
+			{
+				_HeapNode top = pq.top();
+				pq.pop();
+				if (done[top.second])
+					continue;
+				done[top.second] = true;
+				list.push_back(top.second);
+				g.ForeachOutNeighbor(top.second, [&](auto from, auto to, auto w)
+					{
+						if (done[to])
+							return;
+						WT weight = (WT)w + h[from] - h[to];
+						if (weight < (WT)0) //浮点数的舍入误差
+							weight = (WT)0;
+						WT d = top.first + weight;
+						if (d < dist[to])
+						{
+							dist[to] = d;
+							prev[to] = from;
+							pq.emplace(d, to);
+						}
+					});
+			}
+			for (auto v : list) //换算回原来的距离
+			{
+				dist[v] = dist[v] - h[src] + h[v];
+				done[v] = false;
+			}
+			list.clear();
+		});
+}
+
+template<class WT>
+template<class T, class W>
+inline std::vector<WT> JohnsonMSSP<WT>::GetPotential(const GraphBase<T, W>& g) const
+{
+	std::vector<WT> h(g.GetVertexNum(), (WT)0);
+	if (!g.IsWeighted())
+		return h;
+	std::vector<_Edge> edges;
+	bool negative = false;
+	g.ForeachEdge([&](auto from, auto to, auto w)
+		{
+			if ((WT)w < (WT)0)
+				negative = true;
+			edges.push_back({ (size_t)from, (size_t)to, (WT)w });
+		});
+	if (!negative)
+		return h;
+	if (!g.IsDirected()) //无向负权边来回走一次就是负环
+		throw std::invalid_argument("无向图中存在负权边，即存在负环");
+
+	//相当于新增一个到所有顶点权重为0的源点，所以h初始全为0，最多松弛VertexNum-1轮，第VertexNum轮还能松弛说明有负环
+	for (size_t round = 0; round < g.GetVertexNum(); ++round)
+	{
+		bool changed = false;
+		for (auto& e : edges)
+			if (h[e.from] + e.weight < h[e.to])
+			{
+				h[e.to] = h[e.from] + e.weight;
+				changed = true;
+			}
+		if (!changed)
+			return h;
+	}
+	throw std::invalid_argument("图中存在负环");
+}
+
+template<class WT>
+inline void JohnsonMSSP<WT>::SetThreadNum(size_t threadNum)
+{
+	m_threadNum = threadNum;
+}
+
+template<class WT>
+inline size_t JohnsonMSSP<WT>::GetThreadNum() const
+{
+	return m_threadNum;
+}
+
+template<class WT>
+inline size_t JohnsonMSSP<WT>::GetVertexNum() const
+{
+	return m_size;
+}
+
+template<class WT>
+inline size_t JohnsonMSSP<WT>::GetSourceNum() const
+{
+	return m_sources.size();
+}
+
+template<class WT>
+inline size_t JohnsonMSSP<WT>::GetSource(size_t i) const
+{
+	return m_sources[i];
+}
+
+template<class WT>
+inline const std::vector<WT>& JohnsonMSSP<WT>::GetDistanceTable() const
+{
+	return m_dist;
+}
+
+template<class WT>
+inline void JohnsonMSSP<WT>::Clear()
+{
+	m_sources.clear();
+	m_sources.shrink_to_fit();
+	m_row.clear();
+	m_row.shrink_to_fit();
+	m_dist.clear();
+	m_dist.shrink_to_fit();
+	m_prevVertex.clear();
+	m_prevVertex.shrink_to_fit();
+	m_size = 0;
+}
+
+template<class WT>
+inline bool JohnsonMSSP<WT>::IsEmpty() const
+{
+	return m_size == 0;
+}
+
+template<class WT>
+inline bool JohnsonMSSP<WT>::IsSource(size_t src) const
+{
+	return src < m_size && m_row[src] != m_sources.size();
+}
+
+template<class WT>
+inline bool JohnsonMSSP<WT>::IsReachable(size_t src, size_t target) const
+{
+	return m_dist[m_row[src] * m_size + target] != (WT)Infinity;
+}
+
+template<class WT>
+inline WT JohnsonMSSP<WT>::GetDistance(size_t src, size_t target) const
+{
+	return IsReachable(src, target) ? m_dist[m_row[src] * m_size + target] : NullValue;
+}
+
+template<class WT>
+inline void JohnsonMSSP<WT>::ForeachPath(size_t src, size_t target, std::function<void(size_t)> func) const
+{
+	if (!IsReachable(src, target)) //此路不通
+		return;
+	const size_t* prev = m_prevVertex.data() + m_row[src] * m_size;
+	std::stack<size_t> path;
+	for (size_t j = target; j != src; j = prev[j])
+		path.push(j);
+	func(src);
+	while (!path.empty())
+	{
+		func(path.top());
+		path.pop();
+	}
+}
+
+/*批量单源最短路径，一次执行多个源点，不同源点在多个线程中并行执行，算法与SSSP相同(有权图dijkstra，无权图bfs)
+每个线程有自己的工作空间，在多次执行之间保留：距离按时间戳判断是否有效，不需要每个源点都重新分配和清零O(VertexNum)的数组
+结果可以存放在紧凑的距离矩阵中(每个源点一行)，也可以通过回调函数流式输出，后者不需要O(SourceNum*VertexNum)的内存
+WT是权重累加和类型，一般是一个比较大的类型*/
+template<class WT>
+class BatchSSSP
+{
+public:
+
+	static_assert(std::is_arithmetic<WT>::value, "类型WT必须为算数类型");
+
+	static constexpr auto NullValue = static_cast<WT>(-1);
+
+	/*threadNum为线程数，为0时使用硬件线程数*/
+	explicit BatchSSSP(size_t threadNum = 0);
+
+	/*对sources中的每个源点执行sssp，结果存放在距离矩阵中，权重为负数的图会导致算法出错*/
+	template<class T, class W>
+	void Execute(const GraphBase<T, W>& g, const std::vector<size_t>& sources);
+
+	/*对sources中的每个源点执行sssp，不保存结果，每收录一个顶点调用一次func(index, vertex, dist)，index为源点在sources中的下标
+	同一个源点的回调按距离从小到大的顺序在同一个线程中调用，不同源点的回调可能在不同线程中同时调用，func需要是线程安全的*/
+	template<class T, class W, class F>
+	void Execute(const GraphBase<T, W>& g, const std::vector<size_t>& sources, F func);
+
+	/*源点数量，即距离矩阵的行数 O(1)*/
+	size_t GetSourceNum()const;
+
+	/*第index个源点 O(1)*/
+	size_t GetSource(size_t index)const;
+
+	/*顶点数量，即距离矩阵的列数 O(1)*/
+	size_t GetVertexNum()const;
+
+	/*第index个源点到target的最短距离，不通时返回NullValue O(1)*/
+	WT GetDistance(size_t index, size_t target)const;
+
+	/*紧凑的距离矩阵，第index行(index*VertexNum开始的VertexNum个元素)为第index个源点到所有顶点的距离 O(1)*/
+	const std::vector<WT>& GetDistanceTable()const;
+
+	/*获取线程数 O(1)*/
+	size_t GetThreadNum()const;
+
+	/*清除结果并释放所有工作空间*/
+	void Clear();
+
+	/*是否为空 O(1)*/
+	bool IsEmpty()const;
+
+private:
+
+	/*每个线程的工作空间，stamp[v]等于curStamp时dist[v]才有效*/
+	struct _Workspace
+	{
+		std::vector<WT> dist;
+		std::vector<unsigned> stamp;
+		unsigned curStamp = 0;
+		std::vector<std::pair<WT, size_t>> heap;	//用std::push_heap维护的最小堆
+		std::vector<size_t> queue;					//bfs的队列
+	};
+
+	ThreadPool m_pool;
+	std::vector<_Workspace> m_workspaces;
+	std::vector<size_t> m_sources;
+	std::vector<WT> m_dist;
+	size_t m_size = 0;
+
+	/*准备工作空间并开始新一轮时间戳 O(1)，顶点数变化时O(VertexNum)*/
+	void Prepare(_Workspace& ws, size_t num);
+
+	/*从src执行一次sssp，按收录顺序对每个顶点调用func(vertex, dist)*/
+	template<class T, class W, class F>
+	void Search(const GraphBase<T, W>& g, size_t src, _Workspace& ws, F& func);
+};
+
+/*权重为非负整数的批量SSSP*/
+typedef BatchSSSP<unsigned long long> IntegerBatchSSSP;
+/*权重为非负小数的批量SSSP*/
+typedef BatchSSSP<double> DecimalBatchSSSP;
+
+template<class WT>
+inline BatchSSSP<WT>::BatchSSSP(size_t threadNum) :
+	m_pool(threadNum), m_workspaces(m_pool.GetThreadNum())
+{
+}
+
+template<class WT>
+template<class T, class W>
+inline void BatchSSSP<WT>::Execute(const GraphBase<T, W>& g, const std::vector<size_t>& sources)
+{
+	size_t num = g.GetVertexNum();
+	m_sources = sources;
+	m_size = num;
+	m_dist.assign(sources.size() * num, (WT)NullValue);
+	m_pool.Run(sources.size(), [&](size_t index, size_t thread)
+		{
+			WT* row = m_dist.data() + index * num; //每个源点只写自己的行
+			auto func = [row](size_t v, WT dist) { row[v] = dist; };
+			Search(g, sources[index], m_workspaces[thread], func);
+		});
+}
+
+template<class WT>
+template<class T, class W, class F>
+inline void BatchSSSP<WT>::Execute(const GraphBase<T, W>& g, const std::vector<size_t>& sources, F func)
+{
+	m_sources = sources;
+	m_size = g.GetVertexNum();
+	std::vector<WT>().swap(m_dist);
+	m_pool.Run(sources.size(), [&](size_t index, size_t thread)
+		{
+			auto callback = [&](size_t v, WT dist) { func(index, v, dist); };
+			Search(g, sources[index], m_workspaces[thread], callback);
+		});
+}
+
+template<class WT>
+inline void BatchSSSP<WT>::Prepare(_Workspace& ws, size_t num)
+{
+	if (ws.stamp.size() != num)
+	{
+		ws.dist.assign(num, (WT)0);
+		ws.stamp.assign(num, 0);
+		ws.curStamp = 0;
+	}
+	if (++ws.curStamp == 0) //时间戳溢出，全部重置
+	{
+		std::fill(ws.stamp.begin(), ws.stamp.end(), 0);
+		ws.curStamp = 1;
+	}
+	ws.heap.clear();
+	ws.queue.clear();
+}
+
+template<class WT>
+template<class T, class W, class F>
+inline void BatchSSSP<WT>::Search(const GraphBase<T, W>& g, size_t src, _Workspace& ws, F& func)
+{
+	Prepare(ws, g.GetVertexNum());
+	const unsigned cur = ws.curStamp;
+	ws.dist[src] = (WT)0;
+	ws.stamp[src] = cur;
+
+	if (!g.IsWeighted()) //bfs，队列中的顶点就是按距离顺序收录的
+	{
+		ws.queue.push_back(src);
+		for (size_t head = 0; head < ws.queue.size(); ++head)
+		{
+			size_t pos = ws.queue[head];
+			WT dist = ws.dist[pos];
+			func(pos, dist);
+			g.ForeachOutNeighbor(pos, [&](auto i)
+				{
+					if (ws.stamp[i] != cur)
+					{
+						ws.stamp[i] = cur;
+						ws.dist[i] = dist + 1;
+						ws.queue.push_back(i);
+					}
+				});
+		}
+		return;
+	}
+
+	//惰性删除的dijkstra，堆中的距离大于dist时说明该节点已过期
+	std::greater<std::pair<WT, size_t>> cmp;
+	ws.heap.emplace_back((WT)0, src);
+	while (!ws.heap.empty())
+	{
+		std::pop_heap(ws.heap.begin(), ws.heap.end(), cmp);
+		std::pair<WT, size_t> top = ws.heap.back();
+		ws.heap.pop_back();
+		if (top.first > ws.dist[top.second]) //过期的节点
+			continue;
+		func(top.second, top.first);
+		g.ForeachOutNeighbor(top.second, [&](auto /*from*/, auto to, auto w)
+			{
+				WT dist = top.first + (WT)w;
+				if (ws.stamp[to] != cur || dist < ws.dist[to])
+				{
+					ws.stamp[to] = cur;
+					ws.dist[to] = dist;
+					ws.heap.emplace_back(dist, to);
+					std::push_heap(ws.heap.begin(), ws.heap.end(), cmp);
+				}
+			});
+	}
+}
+
+template<class WT>
+inline size_t BatchSSSP<WT>::GetSourceNum() const
+{
+	return m_sources.size();
+}
+
+template<class WT>
+inline size_t BatchSSSP<WT>::GetSource(size_t index) const
+{
+	return m_sources[index];
+}
+
+template<class WT>
+inline size_t BatchSSSP<WT>::GetVertexNum() const
+{
+	return m_size;
+}
+
+template<class WT>
+inline WT BatchSSSP<WT>::GetDistance(size_t index, size_t target) const
+{
+	return m_dist[index * m_size + target];
+}
+
+template<class WT>
+inline const std::vector<WT>& BatchSSSP<WT>::GetDistanceTable() const
+{
+	return m_dist;
+}
+
+template<class WT>
+inline size_t BatchSSSP<WT>::GetThreadNum() const
+{
+	return m_pool.GetThreadNum();
+}
+
+template<class WT>
+inline void BatchSSSP<WT>::Clear()
+{
+	std::vector<size_t>().swap(m_sources);
+	std::vector<WT>().swap(m_dist);
+	for (auto& ws : m_workspaces)
+		ws = _Workspace();
+	m_size = 0;
+}
+
+template<class WT>
+inline bool BatchSSSP<WT>::IsEmpty() const
+{
+	return m_sources.empty();
 }
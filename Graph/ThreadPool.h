@@ -0,0 +1,154 @@
+﻿#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+/*简单的fork-join线程池，用于并行图算法
+线程在构造时创建并一直复用，Run会把[0, taskNum)的任务动态分配给所有线程(包括调用线程)，阻塞到全部完成
+同一时间只能有一个Run在执行，不可重入，任务中抛出的第一个异常会在Run中重新抛出*/
+class ThreadPool
+{
+public:
+
+	/*threadNum为总线程数(包括调用Run的线程)，为0时使用硬件线程数*/
+	explicit ThreadPool(size_t threadNum = 0);
+	ThreadPool(const ThreadPool&) = delete;
+	~ThreadPool();
+
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/*获取总线程数 O(1)*/
+	size_t GetThreadNum()const;
+
+	/*对[0, taskNum)中的每个任务调用func(task, thread)，thread为执行该任务的线程编号[0, GetThreadNum())，可以用来索引线程私有的数据*/
+	template<class F>
+	void Run(size_t taskNum, F func);
+
+private:
+
+	std::vector<std::thread> m_threads;			//工作线程，编号从1开始，0为调用线程
+	std::mutex m_mutex;
+	std::condition_variable m_start;
+	std::condition_variable m_finish;
+	std::function<void(size_t, size_t)> m_func;	//当前的任务
+	std::atomic<size_t> m_nextTask{ 0 };
+	size_t m_taskNum = 0;
+	size_t m_generation = 0;					//每次Run加1，用来唤醒工作线程
+	size_t m_running = 0;						//还没完成当前任务的工作线程数
+	bool m_stop = false;
+	std::exception_ptr m_error;
+
+	/*工作线程的主循环*/
+	void WorkerLoop(size_t thread);
+
+	/*不断领取任务直到全部领完*/
+	void Work(size_t thread);
+};
+
+inline ThreadPool::ThreadPool(size_t threadNum)
+{
+	if (threadNum == 0)
+		threadNum = std::thread::hardware_concurrency();
+	for (size_t i = 1; i < threadNum; ++i)
+		m_threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+
+inline ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_start.notify_all();
+	for (auto& i : m_threads)
+		i.join();
+}
+
+inline size_t ThreadPool::GetThreadNum() const
+{
+	return m_threads.size() + 1;
+}
+
+template<class F>
+inline void ThreadPool::Run(size_t taskNum, F func)
+{
+	if (m_threads.empty() || taskNum <= 1) //没有必要唤醒工作线程
+	{
+		for (size_t i = 0; i < taskNum; ++i)
+			func(i, 0);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_func = [&func](size_t task, size_t thread)
+		{
+			func(task, thread);
+		};
+		m_taskNum = taskNum;
+		m_nextTask = 0;
+		m_running = m_threads.size();
+		m_error = nullptr;
+		++m_generation;
+	}
+	m_start.notify_all();
+	Work(0);
+	std::exception_ptr error;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_finish.wait(lock, [this]
+			{
+				return m_running == 0;
+			});
+		m_func = nullptr;
+		error = m_error;
+	}
+	if (error)
+		std::rethrow_exception(error);
+}
+
+inline void ThreadPool::WorkerLoop(size_t thread)
+{
+	size_t generation = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_start.wait(lock, [&]
+				{
+					return m_stop || m_generation != generation;
+				});
+			if (m_stop)
+				return;
+			generation = m_generation;
+		}
+		Work(thread);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (--m_running == 0)
+				m_finish.notify_one();
+		}
+	}
+}
+
+inline void ThreadPool::Work(size_t thread)
+{
+	for (size_t task; (task = m_nextTask.fetch_add(1)) < m_taskNum;)
+	{
+		try
+		{
+			m_func(task, thread);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_error)
+				m_error = std::current_exception();
+			m_nextTask = m_taskNum; //剩下的任务不再执行
+		}
+	}
+}
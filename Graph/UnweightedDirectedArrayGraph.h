@@ -0,0 +1,429 @@
+﻿#pragma once
+
+#include <algorithm>
+#include "GraphBase.h"
+
+/*注意内存对齐*/
+struct _DefaultUnweightedArrayEdgeType
+{
+	size_t vertex;						//定位顶点下标
+};
+
+/*无权有向有序邻接表图，模板参数W不能修改
+每个顶点的邻接点按下标升序存储在一段连续的数组中，查找边时使用二分查找，比起链表实现的邻接表(Link)：
+	查找/获取权重为O(log(VertexEdgeNum))，遍历邻接点时缓存友好，求两个顶点的公共邻接点时可以直接归并
+	插入和删除边需要移动数组元素，为O(VertexEdgeNum)，但是只是内存的整体移动，通常比链表的遍历快
+E为边类型，其中必须有一个作用域：
+	整形 vertex	//用来存储顶点下标*/
+template<class T, class E = _DefaultUnweightedArrayEdgeType, class W = bool>
+class UnweightedDirectedArrayGraph :public GraphBase<T, W>
+{
+public:
+
+	using typename GraphBase<T, W>::VertexType;
+	using typename GraphBase<T, W>::WeightType;
+	using typename GraphBase<T, W>::VertexPosType;
+	using typename GraphBase<T, W>::OnPassVertex;
+	using typename GraphBase<T, W>::OnPassEdge;
+	using typename GraphBase<T, W>::EdgeTuple;
+
+	/*边类型*/
+	using EdgeType = E;
+
+	/*静态断言，检测类型E是否符合要求*/
+	static_assert(std::is_integral<decltype(E::vertex)>::value, "未定义名为[vertex]的整形字段");
+	static_assert(sizeof(E::vertex) <= sizeof(VertexPosType), "[vertex]的整形字段过大");
+
+	/*插入一个顶点，优先复用被标记删除的下标 O(1)*/
+	virtual VertexPosType InsertVertex(const T& v) override;
+
+	/*插入或删除一条边 O(VertexEdgeNum)*/
+	virtual void InsertEdge(VertexPosType from, VertexPosType to, const W& weight = true) override;
+
+	/*预留顶点的空间*/
+	virtual void Reserve(size_t vertexNum, size_t edgeNum)override;
+
+	/*查找从from到to是否存在边 O(log(VertexEdgeNum))*/
+	virtual bool ExistEdge(VertexPosType from, VertexPosType to)const override;
+
+	/*获取从from到to的权重 无权图中为=ExistEdge O(log(VertexEdgeNum))*/
+	virtual W GetWeight(VertexPosType from, VertexPosType to)const override;
+
+	/*设置从from到to的权重 weight=0删除该边，如果没有则添加 O(VertexEdgeNum)*/
+	virtual void SetWeight(VertexPosType from, VertexPosType to, const W& weight)override;
+
+	/*删除顶点，删完后下标会改变 O(EdgeNum)*/
+	virtual void RemoveVertex(VertexPosType v) override;
+
+	/*删除边 O(VertexEdgeNum)*/
+	virtual void RemoveEdge(VertexPosType from, VertexPosType to) override;
+
+	/*真正删除所有被标记删除的顶点并重新编号，返回旧下标到新下标的映射 O(VertexNum+EdgeNum)*/
+	virtual std::vector<VertexPosType> Compact()override;
+
+	/*遍历出邻接点 O(VertexEdgeNum)*/
+	virtual void ForeachOutNeighbor(VertexPosType v, OnPassVertex func)const override;
+
+	/*遍历入邻接点 O(VertexNum*log(VertexEdgeNum))*/
+	virtual void ForeachInNeighbor(VertexPosType v, OnPassVertex func)const override;
+
+	/*遍历出邻接点*/
+	virtual void ForeachOutNeighbor(VertexPosType v, OnPassEdge func)const override;
+
+	/*遍历入邻接点(在无向图中与@GetOutNeighbor功能相同) O(VertexNum*log(VertexEdgeNum))*/
+	virtual void ForeachInNeighbor(VertexPosType v, OnPassEdge func)const override;
+
+	/*遍历所有边，回调函数第三个参数恒为true O(EdgeNum)*/
+	virtual void ForeachEdge(OnPassEdge func)const override;
+
+	/*获取完整邻接矩阵，二维的邻接矩阵会以行为单位，存储在一维线性表中 O(EdgeNum)*/
+	virtual std::vector<W> GetAdjacencyMatrix()const override;
+
+	/*获取图的主要内存占用量(byte)，包括数组预留的空间*/
+	virtual unsigned long long GetMemoryUsage()const override;
+
+	/*获取出度 O(1)*/
+	size_t GetOutDegree(VertexPosType v)const;
+
+	/*按升序遍历v1与v2的公共出邻接点，两者度数相差很大时使用倍增(galloping)查找，否则直接归并
+	O(min(d1,d2)*log(max(d1,d2)/min(d1,d2)))，d1,d2为两个顶点的出度*/
+	void ForeachCommonOutNeighbor(VertexPosType v1, VertexPosType v2, OnPassVertex func)const;
+
+	virtual constexpr bool IsDirected()const override;
+
+	virtual constexpr bool IsWeighted()const override;
+
+	virtual constexpr bool IsMatrix()const override;
+
+protected:
+	std::vector<std::vector<E>> m_rows; //每个顶点的有序邻接点
+
+	/*批量插入边，排序去重后与每个起点原有的邻接点归并*/
+	virtual void BulkInsertEdges(std::vector<EdgeTuple>& edges)override;
+
+	/*将已排序去重的边与对应顶点原有的邻接点归并，已经存在的边会被跳过，assign(E&, from, weight)用来设置新边的权重
+	返回插入的边数量 O(k+相关顶点的VertexEdgeNum之和)*/
+	template<class F>
+	size_t MergeEdges(const std::vector<EdgeTuple>& edges, F assign);
+
+	/*插入from->to，返回新插入的边，已经存在则返回nullptr O(VertexEdgeNum)*/
+	E* InsertEdgeEntry(VertexPosType from, VertexPosType to);
+
+	/*查找from->to，没有则返回nullptr O(log(VertexEdgeNum))*/
+	E* FindEdgeEntry(VertexPosType from, VertexPosType to);
+	const E* FindEdgeEntry(VertexPosType from, VertexPosType to)const;
+
+	/*在[first, last)中查找第一个vertex>=v的位置*/
+	static const E* LowerBound(const E* first, const E* last, VertexPosType v);
+};
+
+template<class T, class E, class W>
+inline typename UnweightedDirectedArrayGraph<T, E, W>::VertexPosType UnweightedDirectedArrayGraph<T, E, W>::InsertVertex(const T& v)
+{
+	VertexPosType pos;
+	if (this->ReuseRemovedSlot(v, pos)) //被标记删除的顶点没有边，该行是空的
+		return pos;
+	this->m_vertexData.push_back(v);
+	m_rows.emplace_back();
+	return this->m_vertexData.size() - 1;
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::InsertEdge(VertexPosType from, VertexPosType to, const W& weight)
+{
+	if (!weight)
+	{
+		RemoveEdge(from, to);
+		return;
+	}
+	InsertEdgeEntry(from, to);
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::Reserve(size_t vertexNum, size_t edgeNum)
+{
+	GraphBase<T, W>::Reserve(vertexNum, edgeNum);
+	m_rows.reserve(vertexNum);
+}
+
+template<class T, class E, class W>
+inline bool UnweightedDirectedArrayGraph<T, E, W>::ExistEdge(VertexPosType from, VertexPosType to) const
+{
+	return FindEdgeEntry(from, to) != nullptr;
+}
+
+template<class T, class E, class W>
+inline W UnweightedDirectedArrayGraph<T, E, W>::GetWeight(VertexPosType from, VertexPosType to) const
+{
+	return ExistEdge(from, to);
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::SetWeight(VertexPosType from, VertexPosType to, const W& weight)
+{
+	if (weight == (W)0)
+		RemoveEdge(from, to);
+	else
+		InsertEdge(from, to, weight);
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::RemoveVertex(VertexPosType v)
+{
+	this->m_edgeNum -= m_rows[v].size();
+	m_rows.erase(m_rows.begin() + v);
+	this->EraseVertexData(v);
+
+	/*删除所有指向v的边，并将所有记录下标>v的边-1，由于有序，只需要处理v所在位置之后的部分*/
+	for (auto& row : m_rows)
+	{
+		auto it = std::lower_bound(row.begin(), row.end(), v, [](const E& e, VertexPosType v)
+			{
+				return (VertexPosType)e.vertex < v;
+			});
+		if (it != row.end() && (VertexPosType)it->vertex == v)
+		{
+			it = row.erase(it);
+			--this->m_edgeNum;
+		}
+		for (; it != row.end(); ++it)
+			--it->vertex;
+	}
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::RemoveEdge(VertexPosType from, VertexPosType to)
+{
+	E* e = FindEdgeEntry(from, to);
+	if (e == nullptr)
+		return;
+	m_rows[from].erase(m_rows[from].begin() + (e - m_rows[from].data()));
+	--this->m_edgeNum;
+}
+
+template<class T, class E, class W>
+inline std::vector<typename UnweightedDirectedArrayGraph<T, E, W>::VertexPosType> UnweightedDirectedArrayGraph<T, E, W>::Compact()
+{
+	std::vector<VertexPosType> mapping = this->GetCompactMapping();
+	if (this->GetRemovedVertexNum() == 0)
+		return mapping;
+	//映射是单调的，重新编号后每行仍然有序
+	VertexPosType size = 0;
+	for (VertexPosType i = 0; i < m_rows.size(); ++i)
+	{
+		if (mapping[i] == this->NPOS)
+			continue;
+		for (auto& e : m_rows[i])
+			e.vertex = (decltype(e.vertex))mapping[e.vertex];
+		if (size != i)
+			m_rows[size] = std::move(m_rows[i]);
+		++size;
+	}
+	m_rows.resize(size);
+	this->CompactVertexData(mapping);
+	return mapping;
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::ForeachOutNeighbor(VertexPosType v, OnPassVertex func) const
+{
+	for (auto& e : m_rows[v])
+		func((VertexPosType)e.vertex);
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::ForeachInNeighbor(VertexPosType v, OnPassVertex func) const
+{
+	for (VertexPosType i = 0; i < m_rows.size(); ++i)
+		if (ExistEdge(i, v))
+			func(i);
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::ForeachOutNeighbor(VertexPosType v, OnPassEdge func) const
+{
+	for (auto& e : m_rows[v])
+		func(v, (VertexPosType)e.vertex, true);
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
+{
+	for (VertexPosType i = 0; i < m_rows.size(); ++i)
+		if (ExistEdge(i, v))
+			func(i, v, true);
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::ForeachEdge(OnPassEdge func) const
+{
+	for (VertexPosType from = 0; from < m_rows.size(); ++from)
+		for (auto& e : m_rows[from])
+			func(from, (VertexPosType)e.vertex, true);
+}
+
+template<class T, class E, class W>
+inline std::vector<W> UnweightedDirectedArrayGraph<T, E, W>::GetAdjacencyMatrix() const
+{
+	std::vector<W> adjaMetrix(this->m_vertexData.size() * this->m_vertexData.size(), (W)0);
+	ForeachEdge(
+		[&](auto v1, auto v2, auto w)
+		{
+			adjaMetrix[v1 * this->GetVertexNum() + v2] = w;
+		});
+	return adjaMetrix;
+}
+
+template<class T, class E, class W>
+inline unsigned long long UnweightedDirectedArrayGraph<T, E, W>::GetMemoryUsage() const
+{
+	unsigned long long usage = (unsigned long long)m_rows.capacity() * sizeof(std::vector<E>) + sizeof(m_rows);
+	for (auto& row : m_rows)
+		usage += (unsigned long long)row.capacity() * sizeof(E);
+	return usage;
+}
+
+template<class T, class E, class W>
+inline size_t UnweightedDirectedArrayGraph<T, E, W>::GetOutDegree(VertexPosType v) const
+{
+	return m_rows[v].size();
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::ForeachCommonOutNeighbor(VertexPosType v1, VertexPosType v2, OnPassVertex func) const
+{
+	const E* a = m_rows[v1].data(), * aEnd = a + m_rows[v1].size();
+	const E* b = m_rows[v2].data(), * bEnd = b + m_rows[v2].size();
+	if (aEnd - a > bEnd - b)
+	{
+		std::swap(a, b);
+		std::swap(aEnd, bEnd);
+	}
+	if ((bEnd - b) / 16 <= aEnd - a) //度数相近，直接归并
+	{
+		while (a != aEnd && b != bEnd)
+		{
+			if (a->vertex < b->vertex)
+				++a;
+			else if (b->vertex < a->vertex)
+				++b;
+			else
+			{
+				func((VertexPosType)a->vertex);
+				++a;
+				++b;
+			}
+		}
+		return;
+	}
+	for (; a != aEnd && b != bEnd; ++a) //度数相差很大，对较小的一方的每个元素在较大的一方中倍增查找
+	{
+		size_t step = 1;
+		const E* hi = b;
+		while (hi != bEnd && (VertexPosType)hi->vertex < (VertexPosType)a->vertex)
+		{
+			b = hi + 1;
+			hi = (size_t)(bEnd - hi) > step ? hi + step : bEnd;
+			step *= 2;
+		}
+		b = LowerBound(b, hi, (VertexPosType)a->vertex);
+		if (b != bEnd && b->vertex == a->vertex)
+			func((VertexPosType)a->vertex);
+	}
+}
+
+template<class T, class E, class W>
+inline constexpr bool UnweightedDirectedArrayGraph<T, E, W>::IsDirected() const
+{
+	return true;
+}
+
+template<class T, class E, class W>
+inline constexpr bool UnweightedDirectedArrayGraph<T, E, W>::IsWeighted() const
+{
+	return false;
+}
+
+template<class T, class E, class W>
+inline constexpr bool UnweightedDirectedArrayGraph<T, E, W>::IsMatrix() const
+{
+	return false;
+}
+
+template<class T, class E, class W>
+inline void UnweightedDirectedArrayGraph<T, E, W>::BulkInsertEdges(std::vector<EdgeTuple>& edges)
+{
+	this->SortUniqueEdges(edges, true);
+	MergeEdges(edges, [](E& /*e*/, VertexPosType /*from*/, const W& /*w*/) {});
+}
+
+template<class T, class E, class W>
+template<class F>
+inline size_t UnweightedDirectedArrayGraph<T, E, W>::MergeEdges(const std::vector<EdgeTuple>& edges, F assign)
+{
+	size_t count = 0;
+	std::vector<E> merged;
+	for (size_t i = 0; i < edges.size();)
+	{
+		VertexPosType from = std::get<0>(edges[i]);
+		auto& row = m_rows[from];
+		auto it = row.begin();
+		size_t end = i;
+		while (end < edges.size() && std::get<0>(edges[end]) == from)
+			++end;
+		merged.clear();
+		merged.reserve(row.size() + end - i);
+		for (; i < end; ++i)
+		{
+			VertexPosType to = std::get<1>(edges[i]);
+			for (; it != row.end() && (VertexPosType)it->vertex < to; ++it)
+				merged.push_back(*it);
+			if (it != row.end() && (VertexPosType)it->vertex == to) //已经存在
+				continue;
+			merged.emplace_back();
+			merged.back().vertex = (decltype(merged.back().vertex))to;
+			assign(merged.back(), from, std::get<2>(edges[i]));
+			++count;
+		}
+		merged.insert(merged.end(), it, row.end());
+		row.assign(merged.begin(), merged.end()); //按需分配，merged作为所有行共用的缓冲区
+	}
+	this->m_edgeNum += count;
+	return count;
+}
+
+template<class T, class E, class W>
+inline E* UnweightedDirectedArrayGraph<T, E, W>::InsertEdgeEntry(VertexPosType from, VertexPosType to)
+{
+	auto& row = m_rows[from];
+	auto it = row.begin() + (LowerBound(row.data(), row.data() + row.size(), to) - row.data());
+	if (it != row.end() && (VertexPosType)it->vertex == to)
+		return nullptr;
+	it = row.emplace(it);
+	it->vertex = (decltype(it->vertex))to;
+	++this->m_edgeNum;
+	return &*it;
+}
+
+template<class T, class E, class W>
+inline E* UnweightedDirectedArrayGraph<T, E, W>::FindEdgeEntry(VertexPosType from, VertexPosType to)
+{
+	return const_cast<E*>(static_cast<const UnweightedDirectedArrayGraph*>(this)->FindEdgeEntry(from, to));
+}
+
+template<class T, class E, class W>
+inline const E* UnweightedDirectedArrayGraph<T, E, W>::FindEdgeEntry(VertexPosType from, VertexPosType to) const
+{
+	const E* first = m_rows[from].data(), * last = first + m_rows[from].size();
+	const E* e = LowerBound(first, last, to);
+	return (e != last && (VertexPosType)e->vertex == to) ? e : nullptr;
+}
+
+template<class T, class E, class W>
+inline const E* UnweightedDirectedArrayGraph<T, E, W>::LowerBound(const E* first, const E* last, VertexPosType v)
+{
+	return std::lower_bound(first, last, v, [](const E& e, VertexPosType v)
+		{
+			return (VertexPosType)e.vertex < v;
+		});
+}
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "GraphBase.h"
+#include "EdgeAllocator.h"
 
 /*注意内存对齐*/
 struct _DefaultUnweightedEdgeType
@@ -13,8 +14,9 @@ struct _DefaultUnweightedEdgeType
 E为边节点类型，对于总体内存空间占用有很大影响，对于自定义边界点类型来说，其中必须有两个作用域：
 	E  *next	//指向下一个边节点
 	整形 vertex	//用来存储顶点下标
-对于边节点类型来说，应该注意内存对齐问题，另外在x86与x64环境下指针所占空间也不同*/
-template<class T, class E = _DefaultUnweightedEdgeType, class W = bool>
+对于边节点类型来说，应该注意内存对齐问题，另外在x86与x64环境下指针所占空间也不同
+A为边节点的分配策略，默认每个节点单独new/delete，大量插入边时可以使用@PooledEdgeAllocator，详见EdgeAllocator.h*/
+template<class T, class E = _DefaultUnweightedEdgeType, class W = bool, template<class> class A = _DefaultEdgeAllocator>
 class UnweightedDirectedLinkGraph :public GraphBase<T, W>
 {
 public:
@@ -24,9 +26,12 @@ public:
 	using typename GraphBase<T, W>::VertexPosType;
 	using typename GraphBase<T, W>::OnPassVertex;
 	using typename GraphBase<T, W>::OnPassEdge;
+	using typename GraphBase<T, W>::EdgeTuple;
 
 	/*边节点类型*/
 	using EdgeType = E;
+	/*边节点分配器类型*/
+	using AllocatorType = A<E>;
 
 	/*静态断言，检测类型E是否符合要求*/
 	static_assert(std::is_same<decltype(E::next), E*>::value, "未定义字段名为[next]指向自己的指针");
@@ -36,12 +41,15 @@ public:
 	UnweightedDirectedLinkGraph() = default;
 	virtual ~UnweightedDirectedLinkGraph();
 
-	/*插入一个顶点 O(1)*/
+	/*插入一个顶点，优先复用被标记删除的下标 O(1)*/
 	virtual VertexPosType InsertVertex(const T& v) override;
 
 	/*插入或删除一条边 O(VertexEdgeNum)*/
 	virtual void InsertEdge(VertexPosType from, VertexPosType to, const W& weight = true) override;
 
+	/*预留顶点入口以及边节点的空间(边节点是否预留取决于分配器)*/
+	virtual void Reserve(size_t vertexNum, size_t edgeNum)override;
+
 	/*查找从from到to是否存在边 O(VertexEdgeNum)*/
 	virtual bool ExistEdge(VertexPosType from, VertexPosType to)const override;
 
@@ -57,16 +65,19 @@ public:
 	/*删除边 O(VertexEdgeNum)*/
 	virtual void RemoveEdge(VertexPosType from, VertexPosType to) override;
 
+	/*真正删除所有被标记删除的顶点并重新编号，返回旧下标到新下标的映射 O(VertexNum+EdgeNum)*/
+	virtual std::vector<VertexPosType> Compact()override;
+
 	/*遍历出邻接点 O(VertexEdgeNum)*/
 	virtual void ForeachOutNeighbor(VertexPosType v, OnPassVertex func)const override;
 
-	/*遍历入邻接点 O(EdgeNum)*/
+	/*遍历入邻接点 O(EdgeNum)，开启入边索引后为O(VertexInEdgeNum)*/
 	virtual void ForeachInNeighbor(VertexPosType v, OnPassVertex func)const override;
 
 	/*遍历出邻接点*/
 	virtual void ForeachOutNeighbor(VertexPosType v, OnPassEdge func)const override;
 
-	/*遍历入邻接点(在无向图中与@GetOutNeighbor功能相同)*/
+	/*遍历入邻接点(在无向图中与@GetOutNeighbor功能相同) O(EdgeNum)，开启入边索引后为O(VertexInEdgeNum)*/
 	virtual void ForeachInNeighbor(VertexPosType v, OnPassEdge func)const override;
 
 	/*遍历所有边，回调函数第三个参数恒为true O(EdgeNum)*/
@@ -76,9 +87,19 @@ public:
 	virtual std::vector<W> GetAdjacencyMatrix()const override;
 
 	/*获取图的主要内存占用量(byte)，不包括顶点信息(无法精确测量)以及其容器等次要因素的占用量
-	该占用量与权重类型以及该类的实现类的密切相关*/
+	该占用量与权重类型以及该类的实现类的密切相关，开启入边索引时包括入边索引的占用量*/
 	virtual unsigned long long GetMemoryUsage()const override;
 
+	/*开启或关闭入边索引，开启后插入删除边时会同步维护每个顶点的入边，遍历入邻接点不再需要遍历所有顶点
+	每条边额外占用sizeof(VertexPosType)+sizeof(E*)，对无向图没有意义 开启时O(VertexNum+EdgeNum)*/
+	void SetInEdgeIndex(bool enable);
+
+	/*是否开启了入边索引 O(1)*/
+	bool HasInEdgeIndex()const;
+
+	/*入边索引的内存占用量(byte)，未开启时为0*/
+	unsigned long long GetInEdgeIndexMemoryUsage()const;
+
 	virtual constexpr bool IsDirected()const override;
 
 	virtual constexpr bool IsWeighted()const override;
@@ -86,21 +107,44 @@ public:
 	virtual constexpr bool IsMatrix()const override;
 
 protected:
+	/*入边索引中的一项，记录起点以及对应的边节点*/
+	struct _InEdge
+	{
+		VertexPosType from;
+		E* edge;
+	};
+
 	std::vector<E*> m_entry; //邻接表入口
+	A<E> m_allocator; //边节点分配器
+	bool m_hasInEdgeIndex = false;
+	std::vector<std::vector<_InEdge>> m_inEntry; //入边索引，未开启时为空
+
+	/*批量插入边，排序去重后每个起点的邻接表只遍历一次*/
+	virtual void BulkInsertEdges(std::vector<EdgeTuple>& edges)override;
+
+	/*将已排序去重的边接到对应邻接表的末尾，已经存在的边会被跳过，create(from, to, weight)用来构造节点
+	返回插入的节点数量 O(VertexNum+k+相关顶点的VertexEdgeNum之和)*/
+	template<class F>
+	size_t AppendEdges(const std::vector<EdgeTuple>& edges, F create);
 
-	/*构造一个节点*/
-	E* CreateEdgeNode(VertexPosType v);
+	/*构造一个from->to的节点，开启入边索引时会加入索引*/
+	E* CreateEdgeNode(VertexPosType from, VertexPosType to);
 
 	/*销毁一个节点*/
 	void DestroyEdgeNode(E* e);
 
 	/*获取边节点*/
 	E* GetNode(VertexPosType from, VertexPosType to)const;
+
+	/*从入边索引中删除from->to O(VertexInEdgeNum)*/
+	void UnlinkInEdge(VertexPosType from, VertexPosType to);
 };
 
-template<class T, class E, class W>
-inline UnweightedDirectedLinkGraph<T, E, W>::~UnweightedDirectedLinkGraph()
+template<class T, class E, class W, template<class> class A>
+inline UnweightedDirectedLinkGraph<T, E, W, A>::~UnweightedDirectedLinkGraph()
 {
+	if (A<E>::IsBulkFree) //由分配器统一释放
+		return;
 	E* edgeNode, * tmp;
 	for (VertexPosType i = 0; i < m_entry.size(); ++i)
 	{
@@ -114,16 +158,21 @@ inline UnweightedDirectedLinkGraph<T, E, W>::~UnweightedDirectedLinkGraph()
 	}
 }
 
-template<class T, class E, class W>
-inline typename UnweightedDirectedLinkGraph<T, E, W>::VertexPosType UnweightedDirectedLinkGraph<T, E, W>::InsertVertex(const T& v)
+template<class T, class E, class W, template<class> class A>
+inline typename UnweightedDirectedLinkGraph<T, E, W, A>::VertexPosType UnweightedDirectedLinkGraph<T, E, W, A>::InsertVertex(const T& v)
 {
+	VertexPosType pos;
+	if (this->ReuseRemovedSlot(v, pos)) //被标记删除的顶点没有边，入口和入边索引都是空的
+		return pos;
 	this->m_vertexData.push_back(v);
 	m_entry.push_back(nullptr);
+	if (m_hasInEdgeIndex)
+		m_inEntry.emplace_back();
 	return this->m_vertexData.size() - 1;
 }
 
-template<class T, class E, class W>
-inline void UnweightedDirectedLinkGraph<T, E, W>::InsertEdge(VertexPosType from, VertexPosType to, const W& weight)
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::InsertEdge(VertexPosType from, VertexPosType to, const W& weight)
 {
 	if (!weight)
 	{
@@ -134,7 +183,7 @@ inline void UnweightedDirectedLinkGraph<T, E, W>::InsertEdge(VertexPosType from,
 	//遍历出邻接点如果存在这条边就退出，否则直到末尾插入
 	if (m_entry[from] == nullptr)
 	{
-		m_entry[from] = CreateEdgeNode(to);
+		m_entry[from] = CreateEdgeNode(from, to);
 		return;
 	}
 	E* edgeNode = m_entry[from];
@@ -145,23 +194,36 @@ inline void UnweightedDirectedLinkGraph<T, E, W>::InsertEdge(VertexPosType from,
 		edgeNode = edgeNode->next;
 	}
 	if ((VertexPosType)edgeNode->vertex != to) //末尾插入
-		edgeNode->next = CreateEdgeNode(to);
+		edgeNode->next = CreateEdgeNode(from, to);
+}
+
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::Reserve(size_t vertexNum, size_t edgeNum)
+{
+	GraphBase<T, W>::Reserve(vertexNum, edgeNum);
+	m_entry.reserve(vertexNum);
+	if (m_hasInEdgeIndex)
+		m_inEntry.reserve(vertexNum);
+	//无向图每条边有两个节点
+	size_t nodeNum = this->IsDirected() ? edgeNum : edgeNum * 2, usedNum = this->IsDirected() ? this->m_edgeNum : this->m_edgeNum * 2;
+	if (nodeNum > usedNum)
+		m_allocator.Reserve(nodeNum - usedNum);
 }
 
-template<class T, class E, class W>
-inline bool UnweightedDirectedLinkGraph<T, E, W>::ExistEdge(VertexPosType from, VertexPosType to) const
+template<class T, class E, class W, template<class> class A>
+inline bool UnweightedDirectedLinkGraph<T, E, W, A>::ExistEdge(VertexPosType from, VertexPosType to) const
 {
 	return this->GetNode(from, to) != nullptr;
 }
 
-template<class T, class E, class W>
-inline W UnweightedDirectedLinkGraph<T, E, W>::GetWeight(VertexPosType from, VertexPosType to) const
+template<class T, class E, class W, template<class> class A>
+inline W UnweightedDirectedLinkGraph<T, E, W, A>::GetWeight(VertexPosType from, VertexPosType to) const
 {
 	return ExistEdge(from, to);
 }
 
-template<class T, class E, class W>
-inline void UnweightedDirectedLinkGraph<T, E, W>::SetWeight(VertexPosType from, VertexPosType to, const W& weight)
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::SetWeight(VertexPosType from, VertexPosType to, const W& weight)
 {
 	if (weight == (W)0)
 		RemoveEdge(from, to);
@@ -169,8 +231,8 @@ inline void UnweightedDirectedLinkGraph<T, E, W>::SetWeight(VertexPosType from,
 		InsertEdge(from, to, weight);
 }
 
-template<class T, class E, class W>
-inline void UnweightedDirectedLinkGraph<T, E, W>::RemoveVertex(VertexPosType v)
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::RemoveVertex(VertexPosType v)
 {
 	E* edgeNode = m_entry[v], * tmp;
 	while (edgeNode != nullptr) //删除该节点的邻接节点
@@ -180,7 +242,7 @@ inline void UnweightedDirectedLinkGraph<T, E, W>::RemoveVertex(VertexPosType v)
 		DestroyEdgeNode(tmp);
 	}
 	m_entry.erase(m_entry.begin() + v);
-	this->m_vertexData.erase(this->m_vertexData.begin() + v);
+	this->EraseVertexData(v);
 
 	/*需要遍历所有边，将所有记录下标>v的节点数据-1，将所有入邻接点(下标=v)删除*/
 	for (VertexPosType i = 0; i < m_entry.size(); ++i)
@@ -212,16 +274,35 @@ inline void UnweightedDirectedLinkGraph<T, E, W>::RemoveVertex(VertexPosType v)
 			e = e->next;
 		}
 	}
+
+	if (!m_hasInEdgeIndex)
+		return;
+	/*v的入边已经随着v的入边索引一起删除，剩下的只需要删除v的出边并修正起点下标*/
+	m_inEntry.erase(m_inEntry.begin() + v);
+	for (auto& inEdges : m_inEntry)
+	{
+		size_t size = 0;
+		for (auto& i : inEdges)
+			if (i.from != v)
+			{
+				inEdges[size] = i;
+				if (inEdges[size].from > v)
+					--inEdges[size].from;
+				++size;
+			}
+		inEdges.resize(size);
+	}
 }
 
-template<class T, class E, class W>
-inline void UnweightedDirectedLinkGraph<T, E, W>::RemoveEdge(VertexPosType from, VertexPosType to)
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::RemoveEdge(VertexPosType from, VertexPosType to)
 {
 	if (m_entry[from] == nullptr)
 		return;
 	if (m_entry[from]->vertex == to)
 	{
 		E* newHead = m_entry[from]->next;
+		UnlinkInEdge(from, to);
 		DestroyEdgeNode(m_entry[from]);
 		m_entry[from] = newHead;
 		return;
@@ -233,50 +314,94 @@ inline void UnweightedDirectedLinkGraph<T, E, W>::RemoveEdge(VertexPosType from,
 	{
 		E* desEdge = edgeNode->next;
 		edgeNode->next = desEdge->next;
+		UnlinkInEdge(from, to);
 		DestroyEdgeNode(desEdge);
 	}
 }
 
-template<class T, class E, class W>
-inline void UnweightedDirectedLinkGraph<T, E, W>::ForeachOutNeighbor(VertexPosType v, OnPassVertex func) const
+template<class T, class E, class W, template<class> class A>
+inline std::vector<typename UnweightedDirectedLinkGraph<T, E, W, A>::VertexPosType> UnweightedDirectedLinkGraph<T, E, W, A>::Compact()
+{
+	std::vector<VertexPosType> mapping = this->GetCompactMapping();
+	if (this->GetRemovedVertexNum() == 0)
+		return mapping;
+	//被标记删除的顶点没有任何边，只需要把剩下的入口前移，并把所有节点的下标换成新下标
+	VertexPosType size = 0;
+	for (VertexPosType i = 0; i < m_entry.size(); ++i)
+	{
+		if (mapping[i] == this->NPOS)
+			continue;
+		for (E* e = m_entry[i]; e != nullptr; e = e->next)
+			e->vertex = (decltype(e->vertex))mapping[e->vertex];
+		m_entry[size] = m_entry[i];
+		if (m_hasInEdgeIndex)
+		{
+			for (auto& j : m_inEntry[i])
+				j.from = mapping[j.from];
+			if (size != i)
+				m_inEntry[size] = std::move(m_inEntry[i]);
+		}
+		++size;
+	}
+	m_entry.resize(size);
+	if (m_hasInEdgeIndex)
+		m_inEntry.resize(size);
+	this->CompactVertexData(mapping);
+	return mapping;
+}
+
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::ForeachOutNeighbor(VertexPosType v, OnPassVertex func) const
 {
 	for (E* e = m_entry[v]; e != nullptr; e = e->next)
 		func((VertexPosType)e->vertex);
 }
 
-template<class T, class E, class W>
-inline void UnweightedDirectedLinkGraph<T, E, W>::ForeachInNeighbor(VertexPosType v, OnPassVertex func) const
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::ForeachInNeighbor(VertexPosType v, OnPassVertex func) const
 {
+	if (m_hasInEdgeIndex)
+	{
+		for (auto& i : m_inEntry[v])
+			func(i.from);
+		return;
+	}
 	for (VertexPosType i = 0; i < m_entry.size(); ++i)
 		if (ExistEdge(i, v))
 			func(i);
 }
 
-template<class T, class E, class W>
-inline void UnweightedDirectedLinkGraph<T, E, W>::ForeachOutNeighbor(VertexPosType v, OnPassEdge func) const
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::ForeachOutNeighbor(VertexPosType v, OnPassEdge func) const
 {
 	for (E* e = m_entry[v]; e != nullptr; e = e->next)
 		func(v, (VertexPosType)e->vertex, true);
 }
 
-template<class T, class E, class W>
-inline void UnweightedDirectedLinkGraph<T, E, W>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
 {
+	if (m_hasInEdgeIndex)
+	{
+		for (auto& i : m_inEntry[v])
+			func(i.from, v, true);
+		return;
+	}
 	for (VertexPosType i = 0; i < m_entry.size(); ++i)
 		if (ExistEdge(i, v))
 			func(i, v, true);
 }
 
-template<class T, class E, class W>
-inline void UnweightedDirectedLinkGraph<T, E, W>::ForeachEdge(OnPassEdge func) const
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::ForeachEdge(OnPassEdge func) const
 {
 	for (VertexPosType from = 0; from < m_entry.size(); ++from)
 		for (E* e = m_entry[from]; e != nullptr; e = e->next)
 			func(from, e->vertex, true);
 }
 
-template<class T, class E, class W>
-inline std::vector<W> UnweightedDirectedLinkGraph<T, E, W>::GetAdjacencyMatrix() const
+template<class T, class E, class W, template<class> class A>
+inline std::vector<W> UnweightedDirectedLinkGraph<T, E, W, A>::GetAdjacencyMatrix() const
 {
 	std::vector<W> adjaMetrix(this->m_vertexData.size() * this->m_vertexData.size(), false);
 	ForeachEdge(
@@ -287,51 +412,126 @@ inline std::vector<W> UnweightedDirectedLinkGraph<T, E, W>::GetAdjacencyMatrix()
 	return adjaMetrix;
 }
 
-template<class T, class E, class W>
-inline unsigned long long UnweightedDirectedLinkGraph<T, E, W>::GetMemoryUsage() const
+template<class T, class E, class W, template<class> class A>
+inline unsigned long long UnweightedDirectedLinkGraph<T, E, W, A>::GetMemoryUsage() const
 {
-	return (unsigned long long)m_entry.size() * sizeof(E*) + (unsigned long long)this->GetEdgeNum() * sizeof(E) + sizeof(m_entry);
+	return (unsigned long long)m_entry.size() * sizeof(E*) + m_allocator.GetMemoryUsage(this->GetEdgeNum()) + sizeof(m_entry) + GetInEdgeIndexMemoryUsage();
 }
 
-template<class T, class E, class W>
-inline constexpr bool UnweightedDirectedLinkGraph<T, E, W>::IsDirected() const
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::SetInEdgeIndex(bool enable)
+{
+	if (enable == m_hasInEdgeIndex)
+		return;
+	m_hasInEdgeIndex = enable;
+	m_inEntry.clear();
+	m_inEntry.shrink_to_fit();
+	if (!enable)
+		return;
+	m_inEntry.resize(m_entry.size());
+	for (VertexPosType from = 0; from < m_entry.size(); ++from)
+		for (E* e = m_entry[from]; e != nullptr; e = e->next)
+			m_inEntry[(VertexPosType)e->vertex].push_back({ from, e });
+}
+
+template<class T, class E, class W, template<class> class A>
+inline bool UnweightedDirectedLinkGraph<T, E, W, A>::HasInEdgeIndex() const
+{
+	return m_hasInEdgeIndex;
+}
+
+template<class T, class E, class W, template<class> class A>
+inline unsigned long long UnweightedDirectedLinkGraph<T, E, W, A>::GetInEdgeIndexMemoryUsage() const
+{
+	if (!m_hasInEdgeIndex)
+		return 0;
+	unsigned long long usage = (unsigned long long)m_inEntry.capacity() * sizeof(std::vector<_InEdge>) + sizeof(m_inEntry);
+	for (auto& i : m_inEntry)
+		usage += (unsigned long long)i.capacity() * sizeof(_InEdge);
+	return usage;
+}
+
+template<class T, class E, class W, template<class> class A>
+inline constexpr bool UnweightedDirectedLinkGraph<T, E, W, A>::IsDirected() const
 {
 	return true;
 }
 
-template<class T, class E, class W>
-inline constexpr bool UnweightedDirectedLinkGraph<T, E, W>::IsWeighted() const
+template<class T, class E, class W, template<class> class A>
+inline constexpr bool UnweightedDirectedLinkGraph<T, E, W, A>::IsWeighted() const
 {
 	return false;
 }
 
-template<class T, class E, class W>
-inline constexpr bool UnweightedDirectedLinkGraph<T, E, W>::IsMatrix() const
+template<class T, class E, class W, template<class> class A>
+inline constexpr bool UnweightedDirectedLinkGraph<T, E, W, A>::IsMatrix() const
 {
 	return false;
 }
 
-template<class T, class E, class W>
-inline E* UnweightedDirectedLinkGraph<T, E, W>::CreateEdgeNode(VertexPosType v)
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::BulkInsertEdges(std::vector<EdgeTuple>& edges)
+{
+	this->SortUniqueEdges(edges, true);
+	AppendEdges(edges, [this](VertexPosType from, VertexPosType to, const W& /*w*/)
+		{
+			return CreateEdgeNode(from, to);
+		});
+}
+
+template<class T, class E, class W, template<class> class A>
+template<class F>
+inline size_t UnweightedDirectedLinkGraph<T, E, W, A>::AppendEdges(const std::vector<EdgeTuple>& edges, F create)
 {
-	E* e = new E;
-	e->vertex = (decltype(e->vertex))v;
+	std::vector<VertexPosType> mark(m_entry.size(), (VertexPosType)this->NPOS); //mark[to]==from说明from->to已经存在
+	size_t count = 0;
+	for (size_t i = 0; i < edges.size();)
+	{
+		VertexPosType from = std::get<0>(edges[i]);
+		E* tail = nullptr;
+		for (E* e = m_entry[from]; e != nullptr; e = e->next) //标记已有的邻接点并找到末尾
+		{
+			mark[(VertexPosType)e->vertex] = from;
+			tail = e;
+		}
+		for (; i < edges.size() && std::get<0>(edges[i]) == from; ++i)
+		{
+			VertexPosType to = std::get<1>(edges[i]);
+			if (mark[to] == from)
+				continue;
+			mark[to] = from;
+			E* e = create(from, to, std::get<2>(edges[i]));
+			(tail == nullptr ? m_entry[from] : tail->next) = e;
+			tail = e;
+			++count;
+		}
+	}
+	return count;
+}
+
+template<class T, class E, class W, template<class> class A>
+inline E* UnweightedDirectedLinkGraph<T, E, W, A>::CreateEdgeNode(VertexPosType from, VertexPosType to)
+{
+	E* e = m_allocator.Allocate();
+	e->vertex = (decltype(e->vertex))to;
 	e->next = nullptr;
 	++this->m_edgeNum;
+	if (m_hasInEdgeIndex)
+		m_inEntry[to].push_back({ from, e });
 	return e;
 }
 
-template<class T, class E, class W>
-inline void UnweightedDirectedLinkGraph<T, E, W>::DestroyEdgeNode(E* e)
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::DestroyEdgeNode(E* e)
 {
 	if (e == nullptr)
 		return;
-	delete e;
+	m_allocator.Deallocate(e);
 	--this->m_edgeNum;
 }
 
-template<class T, class E, class W>
-inline E* UnweightedDirectedLinkGraph<T, E, W>::GetNode(VertexPosType from, VertexPosType to)const
+template<class T, class E, class W, template<class> class A>
+inline E* UnweightedDirectedLinkGraph<T, E, W, A>::GetNode(VertexPosType from, VertexPosType to)const
 {
 	E* edgeNode = m_entry[from];
 	while (edgeNode != nullptr)
@@ -342,3 +542,18 @@ inline E* UnweightedDirectedLinkGraph<T, E, W>::GetNode(VertexPosType from, Vert
 	}
 	return nullptr;
 }
+
+template<class T, class E, class W, template<class> class A>
+inline void UnweightedDirectedLinkGraph<T, E, W, A>::UnlinkInEdge(VertexPosType from, VertexPosType to)
+{
+	if (!m_hasInEdgeIndex)
+		return;
+	auto& inEdges = m_inEntry[to];
+	for (auto& i : inEdges)
+		if (i.from == from) //与最后一项交换后删除，入边索引不要求有序
+		{
+			i = inEdges.back();
+			inEdges.pop_back();
+			return;
+		}
+}
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "WeightedDirectedMatrixGraph.h"
+#include "BitMatrix.h"
 
 /*该类为W=char的特化，在vector中有较低的存储效率，但是使用效率较高，要使用存储效率较高的类请使用@UnweightedDirectedMatrixGraph_Tiny*/
 template<class T>
@@ -34,10 +35,11 @@ inline void UnweightedDirectedMatrixGraph<T>::InsertEdge(VertexPosType from, Ver
 }
 
 
-/*该类为W=bool的特化，在vector中有较高的存储效率，但是使用效率较低
-注：在vector存储bool时，并不是按照byte存储的而是按照bits打包存储，所以无法获取某一个bool的地址,详见vectot<bool>*/
+/*按位存储的无权有向邻接矩阵图，每个元素只占1位，存储效率很高
+邻接矩阵存储在@BitMatrix中，每行以64位字为单位存储，遍历邻接点时一次可以跳过64个不相邻的顶点
+可以通过GetBitMatrix获取邻接矩阵，配合BitMatrix的整行与/或/差运算实现求公共邻接点等算法*/
 template<class T>
-class UnweightedDirectedMatrixGraph_Tiny : public WeightedDirectedMatrixGraph<T, bool>
+class UnweightedDirectedMatrixGraph_Tiny : public MatrixGraph<T, bool>
 {
 public:
 
@@ -47,26 +49,170 @@ public:
 	using typename GraphBase<T, bool>::OnPassVertex;
 	using typename GraphBase<T, bool>::OnPassEdge;
 
+	/*插入一个顶点 均摊O(VertexNum/64)*/
+	virtual VertexPosType InsertVertex(const T& v)override;
+
 	/*插入一个边 O(1)*/
 	virtual void InsertEdge(VertexPosType from, VertexPosType to, const bool& weight = true) override;
 
+	/*预留vertexNum行vertexNum列的空间*/
+	virtual void Reserve(size_t vertexNum, size_t edgeNum)override;
+
+	/*查找从from到to是否存在边 O(1)*/
+	virtual bool ExistEdge(VertexPosType from, VertexPosType to)const override;
+
+	/*获取从from到to的权重 =ExistEdge O(1)*/
+	virtual bool GetWeight(VertexPosType from, VertexPosType to)const override;
+
+	/*设置从from到to的权重 weight=false删除该边 O(1)*/
+	virtual void SetWeight(VertexPosType from, VertexPosType to, const bool& weight)override;
+
+	/*删除顶点，删完后下标会改变 O(VertexNum^2/64)*/
+	virtual void RemoveVertex(VertexPosType v)override;
+
+	/*遍历出邻接点 O(VertexNum/64+VertexEdgeNum)*/
+	virtual void ForeachOutNeighbor(VertexPosType v, OnPassVertex func)const override;
+
+	/*遍历出邻接点 O(VertexNum/64+VertexEdgeNum)*/
+	virtual void ForeachOutNeighbor(VertexPosType v, OnPassEdge func)const override;
+
+	/*遍历所有边，回调函数第三个参数恒为true O(Ele/64+EdgeNum)*/
+	virtual void ForeachEdge(OnPassEdge func)const override;
+
+	/*获取完整邻接矩阵，二维的邻接矩阵会以行为单位，存储在一维线性表中 O(Ele/64+EdgeNum)*/
+	virtual std::vector<bool> GetAdjacencyMatrix()const override;
+
+	/*将每行的跨度收缩到刚好容纳所有顶点，并释放多余内存*/
+	virtual void Shrink_To_Fit()override;
+
 	/*该数值为主要占用的准确数值*/
 	virtual unsigned long long GetMemoryUsage()const override;
 
+	/*获取按位存储的邻接矩阵，第v行第i位为1表示存在v->i O(1)*/
+	const BitMatrix& GetBitMatrix()const;
+
+	virtual constexpr bool IsDirected()const override;
+
 	virtual constexpr bool IsWeighted()const override;
 
+protected:
+	BitMatrix m_adjaMetrix;
 };
 
+template<class T>
+inline typename UnweightedDirectedMatrixGraph_Tiny<T>::VertexPosType UnweightedDirectedMatrixGraph_Tiny<T>::InsertVertex(const T& v)
+{
+	VertexPosType pos;
+	if (this->ReuseRemovedSlot(v, pos)) //被标记删除的顶点所在的行列都是0
+		return pos;
+	m_adjaMetrix.Extend();
+	this->m_vertexData.push_back(v);
+	return this->m_vertexData.size() - 1;
+}
+
 template<class T>
 inline void UnweightedDirectedMatrixGraph_Tiny<T>::InsertEdge(VertexPosType from, VertexPosType to, const bool& weight)
 {
-	WeightedDirectedMatrixGraph<T, bool>::InsertEdge(from, to, weight);
+	MatrixGraph<T, bool>::InsertEdge(from, to, weight);
+}
+
+template<class T>
+inline void UnweightedDirectedMatrixGraph_Tiny<T>::Reserve(size_t vertexNum, size_t edgeNum)
+{
+	GraphBase<T, bool>::Reserve(vertexNum, edgeNum);
+	m_adjaMetrix.Reserve(vertexNum);
+}
+
+template<class T>
+inline bool UnweightedDirectedMatrixGraph_Tiny<T>::ExistEdge(VertexPosType from, VertexPosType to) const
+{
+	return m_adjaMetrix.Get(from, to);
+}
+
+template<class T>
+inline bool UnweightedDirectedMatrixGraph_Tiny<T>::GetWeight(VertexPosType from, VertexPosType to) const
+{
+	return m_adjaMetrix.Get(from, to);
+}
+
+template<class T>
+inline void UnweightedDirectedMatrixGraph_Tiny<T>::SetWeight(VertexPosType from, VertexPosType to, const bool& weight)
+{
+	m_adjaMetrix.Set(from, to, weight);
+}
+
+template<class T>
+inline void UnweightedDirectedMatrixGraph_Tiny<T>::RemoveVertex(VertexPosType v)
+{
+	//减去出边与入边的数量，自环只算一次
+	this->m_edgeNum -= BitMatrix::Count(m_adjaMetrix.GetRow(v), m_adjaMetrix.GetRowWords());
+	for (VertexPosType i = 0; i < this->GetVertexNum(); ++i)
+		if (i != v && m_adjaMetrix.Get(i, v))
+			--this->m_edgeNum;
+	this->EraseVertexData(v);
+	m_adjaMetrix.Erase(v);
+}
+
+template<class T>
+inline void UnweightedDirectedMatrixGraph_Tiny<T>::ForeachOutNeighbor(VertexPosType v, OnPassVertex func) const
+{
+	BitMatrix::ForeachBit(m_adjaMetrix.GetRow(v), m_adjaMetrix.GetRowWords(), [&](size_t i)
+		{
+			func(i);
+		});
+}
+
+template<class T>
+inline void UnweightedDirectedMatrixGraph_Tiny<T>::ForeachOutNeighbor(VertexPosType v, OnPassEdge func) const
+{
+	BitMatrix::ForeachBit(m_adjaMetrix.GetRow(v), m_adjaMetrix.GetRowWords(), [&](size_t i)
+		{
+			func(v, i, true);
+		});
+}
+
+template<class T>
+inline void UnweightedDirectedMatrixGraph_Tiny<T>::ForeachEdge(OnPassEdge func) const
+{
+	for (VertexPosType i = 0; i < this->GetVertexNum(); ++i)
+		ForeachOutNeighbor(i, func);
+}
+
+template<class T>
+inline std::vector<bool> UnweightedDirectedMatrixGraph_Tiny<T>::GetAdjacencyMatrix() const
+{
+	size_t vertexNum = this->GetVertexNum();
+	std::vector<bool> adjaMetrix(vertexNum * vertexNum, false);
+	for (VertexPosType i = 0; i < vertexNum; ++i)
+		BitMatrix::ForeachBit(m_adjaMetrix.GetRow(i), m_adjaMetrix.GetRowWords(), [&](size_t j)
+			{
+				adjaMetrix[i * vertexNum + j] = true;
+			});
+	return adjaMetrix;
+}
+
+template<class T>
+inline void UnweightedDirectedMatrixGraph_Tiny<T>::Shrink_To_Fit()
+{
+	m_adjaMetrix.Shrink_To_Fit();
 }
 
 template<class T>
 inline unsigned long long UnweightedDirectedMatrixGraph_Tiny<T>::GetMemoryUsage() const
 {
-	return (this->m_adjaMetrix.empty() ? 0 : this->m_adjaMetrix[0].capacity() * this->GetVertexNum() / 8) + (unsigned long long)sizeof(this->m_adjaMetrix);
+	return m_adjaMetrix.GetMemoryUsage();
+}
+
+template<class T>
+inline const BitMatrix& UnweightedDirectedMatrixGraph_Tiny<T>::GetBitMatrix() const
+{
+	return m_adjaMetrix;
+}
+
+template<class T>
+inline constexpr bool UnweightedDirectedMatrixGraph_Tiny<T>::IsDirected() const
+{
+	return true;
 }
 
 template<class T>
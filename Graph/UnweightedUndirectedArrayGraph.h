@@ -0,0 +1,138 @@
+﻿#pragma once
+
+#include "UnweightedDirectedArrayGraph.h"
+
+template<class T, class E = _DefaultUnweightedArrayEdgeType>
+class UnweightedUndirectedArrayGraph :public UnweightedDirectedArrayGraph<T, E, bool>
+{
+public:
+
+	using typename GraphBase<T, bool>::VertexType;
+	using typename GraphBase<T, bool>::WeightType;
+	using typename UnweightedDirectedArrayGraph<T, E, bool>::EdgeType;
+	using typename GraphBase<T, bool>::VertexPosType;
+	using typename GraphBase<T, bool>::OnPassVertex;
+	using typename GraphBase<T, bool>::OnPassEdge;
+	using typename GraphBase<T, bool>::EdgeTuple;
+
+	/*插入或删除一条边 O(VertexEdgeNum)*/
+	virtual void InsertEdge(VertexPosType v1, VertexPosType v2, const bool& weight = true) override;
+
+	/*删除顶点，删完后下标会改变 O(EdgeNum)*/
+	virtual void RemoveVertex(VertexPosType v) override;
+
+	/*删除边 O(VertexEdgeNum)*/
+	virtual void RemoveEdge(VertexPosType v1, VertexPosType v2) override;
+
+	/*遍历入邻接点 O(VertexEdgeNum)*/
+	virtual void ForeachInNeighbor(VertexPosType v, OnPassVertex func)const override;
+
+	/*遍历入邻接点 O(VertexEdgeNum)*/
+	virtual void ForeachInNeighbor(VertexPosType v, OnPassEdge func)const override;
+
+	/*遍历所有边，回调函数第三个参数恒为true O(EdgeNum)*/
+	virtual void ForeachEdge(OnPassEdge func)const override;
+
+	/*获取完整邻接矩阵，二维的邻接矩阵会以行为单位，存储在一维线性表中 O(EdgeNum)*/
+	virtual std::vector<bool> GetAdjacencyMatrix()const override;
+
+	virtual constexpr bool IsDirected()const override;
+
+protected:
+
+	/*批量插入边，每条边会插入两个方向*/
+	virtual void BulkInsertEdges(std::vector<EdgeTuple>& edges)override;
+};
+
+template<class T, class E>
+inline void UnweightedUndirectedArrayGraph<T, E>::InsertEdge(VertexPosType v1, VertexPosType v2, const bool& weight)
+{
+	size_t prevEdgeNum = this->m_edgeNum;
+	UnweightedDirectedArrayGraph<T, E, bool>::InsertEdge(v1, v2, weight); //调用父类插入边v1->v2
+	if (prevEdgeNum == this->m_edgeNum || v1 == v2) //边的数量没改变，说明已经存在这条边了或者如果是环只用添加一条边即可
+		return;
+	UnweightedDirectedArrayGraph<T, E, bool>::InsertEdge(v2, v1, weight); //因为是无向图所以再插v2->v1
+	//因为插入或者删除了两次，所以把边的数量修正一下
+	this->m_edgeNum += (this->m_edgeNum > prevEdgeNum ? -1 : 1);
+}
+
+template<class T, class E>
+inline void UnweightedUndirectedArrayGraph<T, E>::RemoveVertex(VertexPosType v)
+{
+	//v的每个邻接点(包括自环)恰好对应一条边，父类会把两个方向各算一次
+	size_t edgeNum = this->m_edgeNum - this->m_rows[v].size();
+	UnweightedDirectedArrayGraph<T, E, bool>::RemoveVertex(v);
+	this->m_edgeNum = edgeNum;
+}
+
+template<class T, class E>
+inline void UnweightedUndirectedArrayGraph<T, E>::RemoveEdge(VertexPosType v1, VertexPosType v2)
+{
+	//和插入同理
+	size_t prevEdgeNum = this->m_edgeNum;
+	UnweightedDirectedArrayGraph<T, E, bool>::RemoveEdge(v1, v2); //调用父类删除边v1->v2
+	if (prevEdgeNum == this->m_edgeNum || v1 == v2) //边的数量没改变，说明不存在这条边或者是个环[同InsertEdge]
+		return;
+	UnweightedDirectedArrayGraph<T, E, bool>::RemoveEdge(v2, v1); //因为是无向图所以再删v2->v1
+	//因为删除了两次，所以把边的数量修正一下
+	++this->m_edgeNum;
+}
+
+template<class T, class E>
+inline void UnweightedUndirectedArrayGraph<T, E>::ForeachInNeighbor(VertexPosType v, OnPassVertex func) const
+{
+	//对于无向图，出入相同
+	UnweightedDirectedArrayGraph<T, E, bool>::ForeachOutNeighbor(v, func);
+}
+
+template<class T, class E>
+inline void UnweightedUndirectedArrayGraph<T, E>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
+{
+	UnweightedDirectedArrayGraph<T, E, bool>::ForeachOutNeighbor(v, func);
+}
+
+template<class T, class E>
+inline void UnweightedUndirectedArrayGraph<T, E>::ForeachEdge(OnPassEdge func) const
+{
+	//邻接点有序，v1<=v2的部分在每行的末尾
+	for (VertexPosType v1 = 0; v1 < this->m_rows.size(); ++v1)
+	{
+		auto& row = this->m_rows[v1];
+		for (const E* e = this->LowerBound(row.data(), row.data() + row.size(), v1); e != row.data() + row.size(); ++e)
+			func(v1, (VertexPosType)e->vertex, true);
+	}
+}
+
+template<class T, class E>
+inline std::vector<bool> UnweightedUndirectedArrayGraph<T, E>::GetAdjacencyMatrix() const
+{
+	std::vector<bool> adjaMetrix(this->m_vertexData.size() * this->m_vertexData.size(), false);
+	ForeachEdge(
+		[&](auto v1, auto v2, auto /*w*/)
+		{
+			adjaMetrix[v1 * this->GetVertexNum() + v2] = true;
+			adjaMetrix[v2 * this->GetVertexNum() + v1] = true;
+		});
+	return adjaMetrix;
+}
+
+template<class T, class E>
+inline constexpr bool UnweightedUndirectedArrayGraph<T, E>::IsDirected() const
+{
+	return false;
+}
+
+template<class T, class E>
+inline void UnweightedUndirectedArrayGraph<T, E>::BulkInsertEdges(std::vector<EdgeTuple>& edges)
+{
+	this->SortUniqueEdges(edges, false);
+	this->MirrorEdges(edges);
+	//两个方向总是同时存在的，所以插入的邻接点数加上自环数再除以2就是插入的边数
+	size_t prevEdgeNum = this->m_edgeNum, loopNum = 0;
+	size_t entryNum = this->MergeEdges(edges, [&](E& e, VertexPosType from, const bool& /*w*/)
+		{
+			if ((VertexPosType)e.vertex == from)
+				++loopNum;
+		});
+	this->m_edgeNum = prevEdgeNum + (entryNum + loopNum) / 2;
+}
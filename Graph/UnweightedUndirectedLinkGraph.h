@@ -2,21 +2,25 @@
 
 #include "UnweightedDirectedLinkGraph.h"
 
-template<class T, class E = _DefaultUnweightedEdgeType>
-class UnweightedUndirectedLinkGraph :public UnweightedDirectedLinkGraph<T, E>
+template<class T, class E = _DefaultUnweightedEdgeType, template<class> class A = _DefaultEdgeAllocator>
+class UnweightedUndirectedLinkGraph :public UnweightedDirectedLinkGraph<T, E, bool, A>
 {
 public:
 
 	using typename GraphBase<T, bool>::VertexType;
 	using typename GraphBase<T, bool>::WeightType;
-	using typename UnweightedDirectedLinkGraph<T, E>::EdgeType;
+	using typename UnweightedDirectedLinkGraph<T, E, bool, A>::EdgeType;
 	using typename GraphBase<T, bool>::VertexPosType;
 	using typename GraphBase<T, bool>::OnPassVertex;
 	using typename GraphBase<T, bool>::OnPassEdge;
+	using typename GraphBase<T, bool>::EdgeTuple;
 
 	/*插入或删除一条边 O(VertexEdgeNum)*/
 	virtual void InsertEdge(VertexPosType v1, VertexPosType v2, const bool& weight = true) override;
 
+	/*删除顶点，删完后下标会改变 O(EdgeNum)*/
+	virtual void RemoveVertex(VertexPosType v) override;
+
 	/*删除边 O(VertexEdgeNum)*/
 	virtual void RemoveEdge(VertexPosType v1, VertexPosType v2) override;
 
@@ -38,48 +42,64 @@ public:
 
 	virtual constexpr bool IsDirected()const override;
 
+protected:
+
+	/*批量插入边，每条边会插入两个方向的节点*/
+	virtual void BulkInsertEdges(std::vector<EdgeTuple>& edges)override;
+
 };
 
-template<class T, class E>
-inline void UnweightedUndirectedLinkGraph<T, E>::InsertEdge(VertexPosType v1, VertexPosType v2, const bool& weight)
+template<class T, class E, template<class> class A>
+inline void UnweightedUndirectedLinkGraph<T, E, A>::InsertEdge(VertexPosType v1, VertexPosType v2, const bool& weight)
 {
 	size_t prevEdgeNum = this->m_edgeNum;
-	UnweightedDirectedLinkGraph<T, E>::InsertEdge(v1, v2, weight); //调用父类插入边v1->v2
+	UnweightedDirectedLinkGraph<T, E, bool, A>::InsertEdge(v1, v2, weight); //调用父类插入边v1->v2
 	if (prevEdgeNum == this->m_edgeNum || v1 == v2) //边的数量没改变，说明已经存在这条边了或者如果是环只用添加一条边即可
 		return;
-	UnweightedDirectedLinkGraph<T, E>::InsertEdge(v2, v1, weight); //因为是无向图所以再插v2->v1
+	UnweightedDirectedLinkGraph<T, E, bool, A>::InsertEdge(v2, v1, weight); //因为是无向图所以再插v2->v1
 	//因为插入或者删除了两次，所以把边的数量修正一下
 	this->m_edgeNum += (this->m_edgeNum > prevEdgeNum ? -1 : 1);
 }
 
-template<class T, class E>
-inline void UnweightedUndirectedLinkGraph<T, E>::RemoveEdge(VertexPosType v1, VertexPosType v2)
+template<class T, class E, template<class> class A>
+inline void UnweightedUndirectedLinkGraph<T, E, A>::RemoveVertex(VertexPosType v)
+{
+	//v的每个邻接点(包括自环)恰好对应一条边，父类会把两个方向的节点各算一次
+	size_t edgeNum = this->m_edgeNum;
+	for (E* e = this->m_entry[v]; e != nullptr; e = e->next)
+		--edgeNum;
+	UnweightedDirectedLinkGraph<T, E, bool, A>::RemoveVertex(v);
+	this->m_edgeNum = edgeNum;
+}
+
+template<class T, class E, template<class> class A>
+inline void UnweightedUndirectedLinkGraph<T, E, A>::RemoveEdge(VertexPosType v1, VertexPosType v2)
 {
 	//和插入同理
 	size_t prevEdgeNum = this->m_edgeNum;
-	UnweightedDirectedLinkGraph<T, E>::RemoveEdge(v1, v2); //调用父类删除边v1->v2
+	UnweightedDirectedLinkGraph<T, E, bool, A>::RemoveEdge(v1, v2); //调用父类删除边v1->v2
 	if (prevEdgeNum == this->m_edgeNum || v1 == v2) //边的数量没改变，说明不存在这条边或者是个环[同InsertEdge]
 		return;
-	UnweightedDirectedLinkGraph<T, E>::RemoveEdge(v2, v1); //因为是无向图所以再删v2->v1
+	UnweightedDirectedLinkGraph<T, E, bool, A>::RemoveEdge(v2, v1); //因为是无向图所以再删v2->v1
 	//因为删除了两次，所以把边的数量修正一下
 	++this->m_edgeNum;
 }
 
-template<class T, class E>
-inline void UnweightedUndirectedLinkGraph<T, E>::ForeachInNeighbor(VertexPosType v, OnPassVertex func) const
+template<class T, class E, template<class> class A>
+inline void UnweightedUndirectedLinkGraph<T, E, A>::ForeachInNeighbor(VertexPosType v, OnPassVertex func) const
 {
 	//对于无向图，出入相同
-	UnweightedDirectedLinkGraph<T, E>::ForeachOutNeighbor(v, func);
+	UnweightedDirectedLinkGraph<T, E, bool, A>::ForeachOutNeighbor(v, func);
 }
 
-template<class T, class E>
-inline void UnweightedUndirectedLinkGraph<T, E>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
+template<class T, class E, template<class> class A>
+inline void UnweightedUndirectedLinkGraph<T, E, A>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
 {
-	UnweightedDirectedLinkGraph<T, E>::ForeachOutNeighbor(v, func);
+	UnweightedDirectedLinkGraph<T, E, bool, A>::ForeachOutNeighbor(v, func);
 }
 
-template<class T, class E>
-inline void UnweightedUndirectedLinkGraph<T, E>::ForeachEdge(OnPassEdge func) const
+template<class T, class E, template<class> class A>
+inline void UnweightedUndirectedLinkGraph<T, E, A>::ForeachEdge(OnPassEdge func) const
 {
 	for (VertexPosType v1 = 0; v1 < this->m_entry.size(); ++v1)
 		for (E* e = this->m_entry[v1]; e != nullptr; e = e->next)
@@ -87,8 +107,8 @@ inline void UnweightedUndirectedLinkGraph<T, E>::ForeachEdge(OnPassEdge func) co
 				func(v1, e->vertex, true);
 }
 
-template<class T, class E>
-inline std::vector<bool> UnweightedUndirectedLinkGraph<T, E>::GetAdjacencyMatrix() const
+template<class T, class E, template<class> class A>
+inline std::vector<bool> UnweightedUndirectedLinkGraph<T, E, A>::GetAdjacencyMatrix() const
 {
 	std::vector<bool> adjaMetrix(this->m_vertexData.size() * this->m_vertexData.size(), false);
 	ForeachEdge(
@@ -100,14 +120,30 @@ inline std::vector<bool> UnweightedUndirectedLinkGraph<T, E>::GetAdjacencyMatrix
 	return adjaMetrix;
 }
 
-template<class T, class E>
-inline unsigned long long UnweightedUndirectedLinkGraph<T, E>::GetMemoryUsage() const
+template<class T, class E, template<class> class A>
+inline unsigned long long UnweightedUndirectedLinkGraph<T, E, A>::GetMemoryUsage() const
 {
-	return (unsigned long long)this->m_entry.size() * sizeof(E*) + (unsigned long long)this->GetEdgeNum() * sizeof(E) * 2 + sizeof(this->m_entry);
+	return (unsigned long long)this->m_entry.size() * sizeof(E*) + this->m_allocator.GetMemoryUsage(this->GetEdgeNum() * 2) + sizeof(this->m_entry) + this->GetInEdgeIndexMemoryUsage();
 }
 
-template<class T, class E>
-inline constexpr bool UnweightedUndirectedLinkGraph<T, E>::IsDirected() const
+template<class T, class E, template<class> class A>
+inline constexpr bool UnweightedUndirectedLinkGraph<T, E, A>::IsDirected() const
 {
 	return false;
 }
+
+template<class T, class E, template<class> class A>
+inline void UnweightedUndirectedLinkGraph<T, E, A>::BulkInsertEdges(std::vector<EdgeTuple>& edges)
+{
+	this->SortUniqueEdges(edges, false);
+	this->MirrorEdges(edges);
+	//两个方向的节点总是同时存在的，所以插入的节点数加上自环数再除以2就是插入的边数
+	size_t prevEdgeNum = this->m_edgeNum, loopNum = 0;
+	size_t nodeNum = this->AppendEdges(edges, [&](VertexPosType from, VertexPosType to, const bool& /*w*/)
+		{
+			if (from == to)
+				++loopNum;
+			return this->CreateEdgeNode(from, to);
+		});
+	this->m_edgeNum = prevEdgeNum + (nodeNum + loopNum) / 2;
+}
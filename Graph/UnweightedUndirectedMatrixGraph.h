@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "WeightedUndirectedMatrixGraph.h"
+#include "UnweightedDirectedMatrixGraph.h"
 
 /*该类为W=char的特化，在vector中有较低的存储效率，但是使用效率较高，要使用存储效率较高的类请使用@UnweightedUndirectedMatrixGraph_Tiny*/
 template<class T>
@@ -33,10 +34,10 @@ inline constexpr bool UnweightedUndirectedMatrixGraph<T>::IsWeighted() const
 	return false;
 }
 
-/*该类为W=bool的特化，在vector中有较高的存储效率，但是使用效率较低
-注：在vector存储bool时，并不是按照byte存储的而是按照bits打包存储，所以无法获取某一个bool的地址,详见vectot<bool>*/
+/*按位存储的无权无向邻接矩阵图，存储方式参考@UnweightedDirectedMatrixGraph_Tiny
+为了能按行遍历邻接点，这里存储的是完整的对称矩阵而不是对角矩阵，每个元素占1位*/
 template<class T>
-class UnweightedUndirectedMatrixGraph_Tiny : public WeightedUndirectedMatrixGraph<T, bool>
+class UnweightedUndirectedMatrixGraph_Tiny : public UnweightedDirectedMatrixGraph_Tiny<T>
 {
 public:
 
@@ -46,30 +47,69 @@ public:
 	using typename GraphBase<T, bool>::OnPassVertex;
 	using typename GraphBase<T, bool>::OnPassEdge;
 
-	/*插入一个边 O(1)*/
-	virtual void InsertEdge(VertexPosType v1, VertexPosType v2, const bool& weight = true) override;
+	/*设置v1与v2之间的权重 weight=false删除该边 O(1)*/
+	virtual void SetWeight(VertexPosType v1, VertexPosType v2, const bool& weight)override;
 
-	/*该数值为主要占用的准确数值*/
-	virtual unsigned long long GetMemoryUsage()const override;
+	/*删除顶点，删完后下标会改变 O(VertexNum^2/64)*/
+	virtual void RemoveVertex(VertexPosType v)override;
 
-	virtual constexpr bool IsWeighted()const override;
+	/*遍历入邻接点，与出邻接点相同 O(VertexNum/64+VertexEdgeNum)*/
+	virtual void ForeachInNeighbor(VertexPosType v, OnPassVertex func)const override;
+
+	/*遍历入邻接点，与出邻接点相同 O(VertexNum/64+VertexEdgeNum)*/
+	virtual void ForeachInNeighbor(VertexPosType v, OnPassEdge func)const override;
+
+	/*遍历所有边，每条边只遍历一次，回调函数第三个参数恒为true O(Ele/64+EdgeNum)*/
+	virtual void ForeachEdge(OnPassEdge func)const override;
+
+	virtual constexpr bool IsDirected()const override;
 
 };
 
 template<class T>
-inline void UnweightedUndirectedMatrixGraph_Tiny<T>::InsertEdge(VertexPosType v1, VertexPosType v2, const bool& weight)
+inline void UnweightedUndirectedMatrixGraph_Tiny<T>::SetWeight(VertexPosType v1, VertexPosType v2, const bool& weight)
+{
+	this->m_adjaMetrix.Set(v1, v2, weight);
+	this->m_adjaMetrix.Set(v2, v1, weight);
+}
+
+template<class T>
+inline void UnweightedUndirectedMatrixGraph_Tiny<T>::RemoveVertex(VertexPosType v)
+{
+	this->m_edgeNum -= BitMatrix::Count(this->m_adjaMetrix.GetRow(v), this->m_adjaMetrix.GetRowWords());
+	this->EraseVertexData(v);
+	this->m_adjaMetrix.Erase(v);
+}
+
+template<class T>
+inline void UnweightedUndirectedMatrixGraph_Tiny<T>::ForeachInNeighbor(VertexPosType v, OnPassVertex func) const
+{
+	//对于无向图，出入相同
+	this->ForeachOutNeighbor(v, func);
+}
+
+template<class T>
+inline void UnweightedUndirectedMatrixGraph_Tiny<T>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
 {
-	WeightedUndirectedMatrixGraph<T, bool>::InsertEdge(v1, v2, weight);
+	BitMatrix::ForeachBit(this->m_adjaMetrix.GetRow(v), this->m_adjaMetrix.GetRowWords(), [&](size_t i)
+		{
+			func(i, v, true);
+		});
 }
 
 template<class T>
-inline unsigned long long UnweightedUndirectedMatrixGraph_Tiny<T>::GetMemoryUsage() const
+inline void UnweightedUndirectedMatrixGraph_Tiny<T>::ForeachEdge(OnPassEdge func) const
 {
-	return (this->m_adjaMetrix.empty() ? 0 : (unsigned long long)this->m_adjaMetrix.capacity() / 8) + sizeof(this->m_adjaMetrix);
+	for (VertexPosType i = 0; i < this->GetVertexNum(); ++i)
+		this->ForeachOutNeighbor(i, [&](VertexPosType from, VertexPosType to, const bool& /*w*/)
+			{
+				if (from <= to)
+					func(from, to, true);
+			});
 }
 
 template<class T>
-inline constexpr bool UnweightedUndirectedMatrixGraph_Tiny<T>::IsWeighted() const
+inline constexpr bool UnweightedUndirectedMatrixGraph_Tiny<T>::IsDirected() const
 {
 	return false;
 }
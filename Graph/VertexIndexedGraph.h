@@ -0,0 +1,168 @@
+﻿#pragma once
+
+#include <unordered_map>
+#include <utility>
+#include "GraphBase.h"
+
+/*为任意图添加顶点的哈希索引，G为被包装的图类型，H为顶点的哈希函数类型
+GetVertexPos与ExistVertex的平均复杂度降为O(1)，索引由InsertVertex与RemoveVertex维护
+存在相同的顶点时，索引指向下标最小的那个，与GraphBase::GetVertexPos的结果相同
+注：通过GetVertex获取引用修改顶点会使索引失效，修改顶点请使用@SetVertex
+用法：VertexIndexedGraph<WeightedDirectedLinkGraph<std::string>> g;*/
+template<class G, class H = std::hash<typename G::VertexType>>
+class VertexIndexedGraph :public G
+{
+public:
+
+	using typename G::VertexType;
+	using typename G::WeightType;
+	using typename G::VertexPosType;
+	using typename G::OnPassVertex;
+	using typename G::OnPassEdge;
+
+	/*参数原样传给G的构造函数，构造后为已有顶点建立索引 O(VertexNum)*/
+	template<class... Args>
+	explicit VertexIndexedGraph(Args&&... args);
+
+	/*插入一个顶点，并加入索引 O(1)+G::InsertVertex*/
+	virtual VertexPosType InsertVertex(const VertexType& v)override;
+
+	/*删除顶点，删完后下标会改变，索引会同步修正 O(VertexNum)+G::RemoveVertex*/
+	virtual void RemoveVertex(VertexPosType v)override;
+
+	/*标记删除顶点，并从索引中移除 平均O(1)+G::LazyRemoveVertex，被删除的值有重复时O(VertexNum)*/
+	virtual void LazyRemoveVertex(VertexPosType v)override;
+
+	/*重新编号后重建索引 O(VertexNum)+G::Compact*/
+	virtual std::vector<VertexPosType> Compact()override;
+
+	/*查找是否存在顶点 平均O(1)*/
+	virtual bool ExistVertex(const VertexType& v)const override;
+
+	/*获取顶点所在下标，没有则返回NPOS 平均O(1)*/
+	virtual size_t GetVertexPos(const VertexType& v)const override;
+
+	/*获取顶点所在下标，没有则插入该顶点 平均O(1)+G::InsertVertex*/
+	VertexPosType GetOrInsertVertex(const VertexType& v);
+
+	/*修改顶点，同时修正索引 平均O(1)，被替换的值有重复时O(VertexNum)*/
+	void SetVertex(VertexPosType pos, const VertexType& v);
+
+private:
+
+	std::unordered_map<VertexType, VertexPosType, H> m_index;
+
+	/*为所有未被标记删除的顶点建立索引 O(VertexNum)*/
+	void BuildIndex();
+
+	/*值为v的顶点从pos处移走后，将索引指向剩下的第一个相同顶点，没有则删除 O(VertexNum)*/
+	void ReindexValue(const VertexType& v, VertexPosType pos);
+};
+
+template<class G, class H>
+template<class ...Args>
+inline VertexIndexedGraph<G, H>::VertexIndexedGraph(Args && ...args) :
+	G(std::forward<Args>(args)...)
+{
+	BuildIndex();
+}
+
+template<class G, class H>
+inline typename VertexIndexedGraph<G, H>::VertexPosType VertexIndexedGraph<G, H>::InsertVertex(const VertexType& v)
+{
+	VertexPosType pos = G::InsertVertex(v);
+	auto it = m_index.emplace(v, pos).first; //已经存在相同顶点时保留较小的下标(复用的下标可能更小)
+	if (it->second > pos)
+		it->second = pos;
+	return pos;
+}
+
+template<class G, class H>
+inline void VertexIndexedGraph<G, H>::RemoveVertex(VertexPosType v)
+{
+	bool isRemoved = this->IsVertexRemoved(v);
+	VertexType removed = this->m_vertexData[v];
+	G::RemoveVertex(v);
+	for (auto& i : m_index) //下标大于v的顶点都前移了一位
+		if (i.second > v)
+			--i.second;
+	if (!isRemoved) //被标记删除的顶点已经不在索引中了
+		ReindexValue(removed, v);
+}
+
+template<class G, class H>
+inline void VertexIndexedGraph<G, H>::LazyRemoveVertex(VertexPosType v)
+{
+	if (this->IsVertexRemoved(v))
+		return;
+	G::LazyRemoveVertex(v);
+	ReindexValue(this->m_vertexData[v], v);
+}
+
+template<class G, class H>
+inline std::vector<typename VertexIndexedGraph<G, H>::VertexPosType> VertexIndexedGraph<G, H>::Compact()
+{
+	std::vector<VertexPosType> mapping = G::Compact();
+	BuildIndex();
+	return mapping;
+}
+
+template<class G, class H>
+inline bool VertexIndexedGraph<G, H>::ExistVertex(const VertexType& v) const
+{
+	return m_index.find(v) != m_index.end();
+}
+
+template<class G, class H>
+inline size_t VertexIndexedGraph<G, H>::GetVertexPos(const VertexType& v) const
+{
+	auto it = m_index.find(v);
+	return it == m_index.end() ? this->NPOS : it->second;
+}
+
+template<class G, class H>
+inline typename VertexIndexedGraph<G, H>::VertexPosType VertexIndexedGraph<G, H>::GetOrInsertVertex(const VertexType& v)
+{
+	auto it = m_index.find(v);
+	if (it != m_index.end())
+		return it->second;
+	return InsertVertex(v);
+}
+
+template<class G, class H>
+inline void VertexIndexedGraph<G, H>::SetVertex(VertexPosType pos, const VertexType& v)
+{
+	VertexType old = this->m_vertexData[pos];
+	this->m_vertexData[pos] = v;
+	auto it = m_index.find(v);
+	if (it == m_index.end())
+		m_index.emplace(v, pos);
+	else if (it->second > pos)
+		it->second = pos;
+	ReindexValue(old, pos);
+}
+
+template<class G, class H>
+inline void VertexIndexedGraph<G, H>::BuildIndex()
+{
+	m_index.clear();
+	m_index.reserve(this->m_vertexData.size());
+	for (VertexPosType i = 0; i < this->m_vertexData.size(); ++i)
+		if (!this->IsVertexRemoved(i))
+			m_index.emplace(this->m_vertexData[i], i);
+}
+
+template<class G, class H>
+inline void VertexIndexedGraph<G, H>::ReindexValue(const VertexType& v, VertexPosType pos)
+{
+	auto it = m_index.find(v);
+	if (it == m_index.end() || (it->second != pos && this->m_vertexData[it->second] == v && !this->IsVertexRemoved(it->second)))
+		return; //索引仍然有效
+	for (VertexPosType i = pos; i < this->m_vertexData.size(); ++i) //pos之前不可能有相同的顶点
+		if (this->m_vertexData[i] == v && !this->IsVertexRemoved(i))
+		{
+			it->second = i;
+			return;
+		}
+	m_index.erase(it);
+}
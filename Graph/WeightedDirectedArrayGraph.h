@@ -0,0 +1,130 @@
+﻿#pragma once
+
+#include "UnweightedDirectedArrayGraph.h"
+
+/*注意内存对齐*/
+template<class W>
+struct _DefaultWeightedArrayEdgeType
+{
+	size_t vertex;						//定位顶点下标
+	W weight;							//权重
+};
+
+/*比起无权图，有权图的边多了个weight域，边格式请参考@UnweightedDirectedArrayGraph*/
+template<class T, class W = int, class E = _DefaultWeightedArrayEdgeType<W>>
+class WeightedDirectedArrayGraph :public UnweightedDirectedArrayGraph<T, E, W>
+{
+public:
+
+	using typename GraphBase<T, W>::VertexType;
+	using typename GraphBase<T, W>::WeightType;
+	using typename UnweightedDirectedArrayGraph<T, E, W>::EdgeType;
+	using typename GraphBase<T, W>::VertexPosType;
+	using typename GraphBase<T, W>::OnPassVertex;
+	using typename GraphBase<T, W>::OnPassEdge;
+	using typename GraphBase<T, W>::EdgeTuple;
+
+	static_assert(std::is_same<W, decltype(E::weight)>::value, "无[weight]字段或者该字段类型与权重类型不符");
+
+	/*插入或删除一条边，已经存在时不修改权重 O(VertexEdgeNum)*/
+	virtual void InsertEdge(VertexPosType from, VertexPosType to, const W& weight) override;
+
+	/*获取从from到to的权重 O(log(VertexEdgeNum))*/
+	virtual W GetWeight(VertexPosType from, VertexPosType to)const override;
+
+	/*设置从from到to的权重 weight=0删除该边，如果没有则添加 修改为O(log(VertexEdgeNum))，添加删除为O(VertexEdgeNum)*/
+	virtual void SetWeight(VertexPosType from, VertexPosType to, const W& weight)override;
+
+	/*遍历出邻接点*/
+	virtual void ForeachOutNeighbor(VertexPosType v, OnPassEdge func)const override;
+
+	/*遍历入邻接点(在无向图中与@GetOutNeighbor功能相同) O(VertexNum*log(VertexEdgeNum))*/
+	virtual void ForeachInNeighbor(VertexPosType v, OnPassEdge func)const override;
+
+	/*遍历所有边 O(EdgeNum)*/
+	virtual void ForeachEdge(OnPassEdge func)const override;
+
+	virtual constexpr bool IsWeighted()const override;
+
+protected:
+
+	/*批量插入边，排序去重后与每个起点原有的邻接点归并*/
+	virtual void BulkInsertEdges(std::vector<EdgeTuple>& edges)override;
+};
+
+template<class T, class W, class E>
+inline void WeightedDirectedArrayGraph<T, W, E>::InsertEdge(VertexPosType from, VertexPosType to, const W& weight)
+{
+	if (weight == (W)0)
+	{
+		this->RemoveEdge(from, to);
+		return;
+	}
+	E* e = this->InsertEdgeEntry(from, to);
+	if (e != nullptr)
+		e->weight = weight;
+}
+
+template<class T, class W, class E>
+inline W WeightedDirectedArrayGraph<T, W, E>::GetWeight(VertexPosType from, VertexPosType to) const
+{
+	const E* e = this->FindEdgeEntry(from, to);
+	return e == nullptr ? (W)0 : e->weight;
+}
+
+template<class T, class W, class E>
+inline void WeightedDirectedArrayGraph<T, W, E>::SetWeight(VertexPosType from, VertexPosType to, const W& weight)
+{
+	if (weight == (W)0)
+	{
+		this->RemoveEdge(from, to);
+		return;
+	}
+	E* e = this->FindEdgeEntry(from, to);
+	if (e == nullptr)
+		this->InsertEdge(from, to, weight);
+	else
+		e->weight = weight;
+}
+
+template<class T, class W, class E>
+inline void WeightedDirectedArrayGraph<T, W, E>::ForeachOutNeighbor(VertexPosType v, OnPassEdge func) const
+{
+	for (auto& e : this->m_rows[v])
+		func(v, (VertexPosType)e.vertex, e.weight);
+}
+
+template<class T, class W, class E>
+inline void WeightedDirectedArrayGraph<T, W, E>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
+{
+	for (VertexPosType i = 0; i < this->m_rows.size(); ++i)
+	{
+		const E* e = this->FindEdgeEntry(i, v);
+		if (e != nullptr)
+			func(i, v, e->weight);
+	}
+}
+
+template<class T, class W, class E>
+inline void WeightedDirectedArrayGraph<T, W, E>::ForeachEdge(OnPassEdge func) const
+{
+	for (VertexPosType from = 0; from < this->m_rows.size(); ++from)
+		for (auto& e : this->m_rows[from])
+			func(from, (VertexPosType)e.vertex, e.weight);
+}
+
+template<class T, class W, class E>
+inline constexpr bool WeightedDirectedArrayGraph<T, W, E>::IsWeighted() const
+{
+	return true;
+}
+
+template<class T, class W, class E>
+inline void WeightedDirectedArrayGraph<T, W, E>::BulkInsertEdges(std::vector<EdgeTuple>& edges)
+{
+	this->SortUniqueEdges(edges, true);
+	this->MergeEdges(edges, [](E& e, VertexPosType /*from*/, const W& w)
+		{
+			e.weight = w;
+		});
+}
@@ -19,17 +19,18 @@ x86:按4字节内存对齐
 	weight : int	->	short		4 -> 2 byte
 这样比默认的结构体就少了4字节
 */
-template<class T, class W = int, class E = _DefaultWeightedEdgeType<W>>
-class WeightedDirectedLinkGraph :public UnweightedDirectedLinkGraph<T, E, W>
+template<class T, class W = int, class E = _DefaultWeightedEdgeType<W>, template<class> class A = _DefaultEdgeAllocator>
+class WeightedDirectedLinkGraph :public UnweightedDirectedLinkGraph<T, E, W, A>
 {
 public:
 
 	using typename GraphBase<T, W>::VertexType;
 	using typename GraphBase<T, W>::WeightType;
-	using typename UnweightedDirectedLinkGraph<T, E, W>::EdgeType;
+	using typename UnweightedDirectedLinkGraph<T, E, W, A>::EdgeType;
 	using typename GraphBase<T, W>::VertexPosType;
 	using typename GraphBase<T, W>::OnPassVertex;
 	using typename GraphBase<T, W>::OnPassEdge;
+	using typename GraphBase<T, W>::EdgeTuple;
 
 	static_assert(std::is_same<W, decltype(E::weight)>::value, "无[weight]字段或者该字段类型与权重类型不符");
 
@@ -45,7 +46,7 @@ public:
 	/*遍历出邻接点*/
 	virtual void ForeachOutNeighbor(VertexPosType v, OnPassEdge func)const override;
 
-	/*遍历入邻接点(在无向图中与@GetOutNeighbor功能相同)*/
+	/*遍历入邻接点(在无向图中与@GetOutNeighbor功能相同) O(EdgeNum)，开启入边索引后为O(VertexInEdgeNum)*/
 	virtual void ForeachInNeighbor(VertexPosType v, OnPassEdge func)const override;
 
 	/*遍历所有边，回调函数第三个参数恒为true O(EdgeNum)*/
@@ -55,12 +56,15 @@ public:
 
 protected:
 
-	/*构造一个节点*/
-	E* CreateEdgeNode(VertexPosType v, const W& w);
+	/*批量插入边，排序去重后每个起点的邻接表只遍历一次*/
+	virtual void BulkInsertEdges(std::vector<EdgeTuple>& edges)override;
+
+	/*构造一个from->to的节点，开启入边索引时会加入索引*/
+	E* CreateEdgeNode(VertexPosType from, VertexPosType to, const W& w);
 };
 
-template<class T, class W, class E>
-inline void WeightedDirectedLinkGraph<T, W, E>::InsertEdge(VertexPosType from, VertexPosType to, const W& weight)
+template<class T, class W, class E, template<class> class A>
+inline void WeightedDirectedLinkGraph<T, W, E, A>::InsertEdge(VertexPosType from, VertexPosType to, const W& weight)
 {
 	if (weight == (W)0)
 	{
@@ -70,7 +74,7 @@ inline void WeightedDirectedLinkGraph<T, W, E>::InsertEdge(VertexPosType from, V
 
 	if (this->m_entry[from] == nullptr)
 	{
-		this->m_entry[from] = CreateEdgeNode(to, weight);
+		this->m_entry[from] = CreateEdgeNode(from, to, weight);
 		return;
 	}
 	E* edgeNode = this->m_entry[from];
@@ -81,18 +85,18 @@ inline void WeightedDirectedLinkGraph<T, W, E>::InsertEdge(VertexPosType from, V
 		edgeNode = edgeNode->next;
 	}
 	if ((VertexPosType)edgeNode->vertex != to)
-		edgeNode->next = CreateEdgeNode(to, weight);
+		edgeNode->next = CreateEdgeNode(from, to, weight);
 }
 
-template<class T, class W, class E>
-inline W WeightedDirectedLinkGraph<T, W, E>::GetWeight(VertexPosType from, VertexPosType to) const
+template<class T, class W, class E, template<class> class A>
+inline W WeightedDirectedLinkGraph<T, W, E, A>::GetWeight(VertexPosType from, VertexPosType to) const
 {
 	E* e = this->GetNode(from, to);
 	return (e == nullptr ? (W)0 : e->weight);
 }
 
-template<class T, class W, class E>
-inline void WeightedDirectedLinkGraph<T, W, E>::SetWeight(VertexPosType from, VertexPosType to, const W& weight)
+template<class T, class W, class E, template<class> class A>
+inline void WeightedDirectedLinkGraph<T, W, E, A>::SetWeight(VertexPosType from, VertexPosType to, const W& weight)
 {
 	if (weight == (W)0)
 	{
@@ -100,6 +104,11 @@ inline void WeightedDirectedLinkGraph<T, W, E>::SetWeight(VertexPosType from, Ve
 		return;
 	}
 	/*查找该节点，如果没有就插入*/
+	if (this->m_entry[from] == nullptr)
+	{
+		this->m_entry[from] = CreateEdgeNode(from, to, weight);
+		return;
+	}
 	if (this->m_entry[from]->vertex == to)
 	{
 		this->m_entry[from]->weight = weight;
@@ -113,19 +122,25 @@ inline void WeightedDirectedLinkGraph<T, W, E>::SetWeight(VertexPosType from, Ve
 			break;
 		}
 	if (e->next == nullptr)
-		e->next = CreateEdgeNode(to, weight);
+		e->next = CreateEdgeNode(from, to, weight);
 }
 
-template<class T, class W, class E>
-inline void WeightedDirectedLinkGraph<T, W, E>::ForeachOutNeighbor(VertexPosType v, OnPassEdge func) const
+template<class T, class W, class E, template<class> class A>
+inline void WeightedDirectedLinkGraph<T, W, E, A>::ForeachOutNeighbor(VertexPosType v, OnPassEdge func) const
 {
 	for (E* e = this->m_entry[v]; e != nullptr; e = e->next)
 		func(v, (VertexPosType)e->vertex, e->weight);
 }
 
-template<class T, class W, class E>
-inline void WeightedDirectedLinkGraph<T, W, E>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
+template<class T, class W, class E, template<class> class A>
+inline void WeightedDirectedLinkGraph<T, W, E, A>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
 {
+	if (this->m_hasInEdgeIndex)
+	{
+		for (auto& i : this->m_inEntry[v])
+			func(i.from, v, i.edge->weight);
+		return;
+	}
 	for (VertexPosType i = 0; i < this->m_entry.size(); ++i)
 	{
 		W w = GetWeight(i, v);
@@ -134,24 +149,34 @@ inline void WeightedDirectedLinkGraph<T, W, E>::ForeachInNeighbor(VertexPosType
 	}
 }
 
-template<class T, class W, class E>
-inline void WeightedDirectedLinkGraph<T, W, E>::ForeachEdge(OnPassEdge func) const
+template<class T, class W, class E, template<class> class A>
+inline void WeightedDirectedLinkGraph<T, W, E, A>::ForeachEdge(OnPassEdge func) const
 {
 	for (VertexPosType i = 0; i < this->m_entry.size(); ++i)
 		for (E* e = this->m_entry[i]; e != nullptr; e = e->next)
 			func(i, e->vertex, e->weight);
 }
 
-template<class T, class W, class E>
-inline constexpr bool WeightedDirectedLinkGraph<T, W, E>::IsWeighted() const
+template<class T, class W, class E, template<class> class A>
+inline constexpr bool WeightedDirectedLinkGraph<T, W, E, A>::IsWeighted() const
 {
 	return true;
 }
 
-template<class T, class W, class E>
-inline E* WeightedDirectedLinkGraph<T, W, E>::CreateEdgeNode(VertexPosType v, const W& w)
+template<class T, class W, class E, template<class> class A>
+inline void WeightedDirectedLinkGraph<T, W, E, A>::BulkInsertEdges(std::vector<EdgeTuple>& edges)
+{
+	this->SortUniqueEdges(edges, true);
+	this->AppendEdges(edges, [this](VertexPosType from, VertexPosType to, const W& w)
+		{
+			return CreateEdgeNode(from, to, w);
+		});
+}
+
+template<class T, class W, class E, template<class> class A>
+inline E* WeightedDirectedLinkGraph<T, W, E, A>::CreateEdgeNode(VertexPosType from, VertexPosType to, const W& w)
 {
-	E* e = UnweightedDirectedLinkGraph<T, E, W>::CreateEdgeNode(v);
+	E* e = UnweightedDirectedLinkGraph<T, E, W, A>::CreateEdgeNode(from, to);
 	e->weight = w;
 	return e;
 }
@@ -1,8 +1,10 @@
 ﻿#pragma once
 
+#include <algorithm>
 #include "MatrixGraph.h"
 
-/*有向邻接矩阵图，内存占用较大*/
+/*有向邻接矩阵图，内存占用较大
+邻接矩阵以行为单位连续存储在一个线性表中，每行的长度(跨度)会预留空间，跨度不够时按1.5倍扩展，所以插入顶点均摊为O(VertexNum)*/
 template<class T, class W = int>
 class WeightedDirectedMatrixGraph :public MatrixGraph<T, W>
 {
@@ -13,107 +15,215 @@ public:
 	using typename GraphBase<T, W>::OnPassVertex;
 	using typename GraphBase<T, W>::OnPassEdge;
 
-	/*插入一个顶点 O(VertexNum)*/
+	/*插入一个顶点 均摊O(VertexNum)*/
 	virtual VertexPosType InsertVertex(const T& v)override;
 
+	/*将跨度扩展到至少vertexNum，并预留vertexNum行的空间，之后插入顶点不需要重新排列矩阵*/
+	virtual void Reserve(size_t vertexNum, size_t edgeNum)override;
+
 	/*获取从from到to的权重 O(1)*/
 	virtual W GetWeight(VertexPosType from, VertexPosType to)const override;
 
 	/*设置从from到to的权重 weight=0删除该边，如果没有则添加 O(1)*/
 	virtual void SetWeight(VertexPosType from, VertexPosType to, const W& weight);
 
-	/*删除顶点，删完后下标会改变 O(1)-O(Ele) (下标越大速度越快)*/
+	/*删除顶点，删完后下标会改变 O(VertexNum)-O(Ele) (下标越大速度越快)*/
 	virtual void RemoveVertex(VertexPosType v)override;
 
+	/*真正删除所有被标记删除的顶点并重新编号，所有行列一次压缩完成 O(Ele)*/
+	virtual std::vector<VertexPosType> Compact()override;
+
+	/*遍历出邻接点，直接扫描该行 O(VertexNum)*/
+	virtual void ForeachOutNeighbor(VertexPosType v, OnPassVertex func)const override;
+
+	/*遍历出邻接点，直接扫描该行 O(VertexNum)*/
+	virtual void ForeachOutNeighbor(VertexPosType v, OnPassEdge func)const override;
+
 	/*遍历所有边 O(Ele)*/
 	virtual void ForeachEdge(OnPassEdge func)const override;
 
-	/*获取完整邻接矩阵，二维的邻接矩阵会以行为单位，存储在一维线性表中 O(Ele-) (经过vector优化过应该介于Ele和VertexNum之间)*/
+	/*获取完整邻接矩阵，二维的邻接矩阵会以行为单位，存储在一维线性表中 O(Ele)
+	跨度与顶点数相同时(如调用Shrink_To_Fit后)为一次整体复制，否则逐行复制*/
 	virtual std::vector<W> GetAdjacencyMatrix()const override;
 
-	/*收缩内存占用，在每次移除一个顶点时并不会真的释放内存，从而提高再次插入顶点效率，详见@vector
+	/*收缩内存占用，将跨度收缩为顶点数，并释放多余的内存 O(Ele)
 	如果不需要插入顶点或者需要收缩内存，请调用这个
 	内部调用@vector.shrink_to_fit*/
 	virtual void Shrink_To_Fit()override;
 
-	/*实际占用要大于该数值，因为vector会预留空间，调用Shrink_To_Fit函数后可能更趋近于该数值*/
+	/*该数值为主要占用的准确数值，包括预留的空间*/
 	virtual unsigned long long GetMemoryUsage()const override;
 
+	/*获取每行的跨度(预留的列数) O(1)*/
+	size_t GetStride()const;
+
+	/*v行的连续存储，前VertexNum个元素有效，插入顶点后可能失效 O(1)*/
+	const W* GetRow(VertexPosType v)const;
+
+	/*同@GetRow，len为VertexNum O(1)*/
+	virtual const W* GetRowData(VertexPosType v, size_t& len)const override;
+
 	virtual constexpr bool IsDirected()const override;
 
 	virtual constexpr bool IsWeighted()const override;
 
 protected:
-	std::vector<std::vector<W>> m_adjaMetrix;
+	std::vector<W> m_adjaMetrix; //行优先存储，from行to列位于from*m_stride+to，超出顶点数的部分恒为0
+	size_t m_stride = 0;
+
+	/*重新排列矩阵，使每行的跨度变为stride O(Ele)*/
+	void Relayout(size_t stride);
 };
 
 template<class T, class W>
 inline typename WeightedDirectedMatrixGraph<T, W>::VertexPosType WeightedDirectedMatrixGraph<T, W>::InsertVertex(const T& v)
 {
+	VertexPosType pos;
+	if (this->ReuseRemovedSlot(v, pos)) //被标记删除的顶点所在的行列都是0
+		return pos;
+	size_t vertexNum = this->GetVertexNum();
+	if (vertexNum == m_stride) //跨度不够，扩展后新的一列已经是0了
+		Relayout(m_stride < 8 ? 8 : m_stride + m_stride / 2);
+	m_adjaMetrix.resize((vertexNum + 1) * m_stride, (W)0); //扩展一行
 	this->m_vertexData.push_back(v);
-	for (auto& i : m_adjaMetrix) //扩展一列
-		i.push_back((W)0);
-	std::vector<W> last(this->GetVertexNum(), (W)0);
-	m_adjaMetrix.push_back(std::move(last)); //扩展一行
-	return this->m_vertexData.size() - 1;
+	return vertexNum;
+}
+
+template<class T, class W>
+inline void WeightedDirectedMatrixGraph<T, W>::Reserve(size_t vertexNum, size_t edgeNum)
+{
+	GraphBase<T, W>::Reserve(vertexNum, edgeNum);
+	if (vertexNum > m_stride)
+		Relayout(vertexNum);
+	m_adjaMetrix.reserve(vertexNum * m_stride);
 }
 
 template<class T, class W>
 inline W WeightedDirectedMatrixGraph<T, W>::GetWeight(VertexPosType from, VertexPosType to)const
 {
-	return m_adjaMetrix[from][to];
+	return m_adjaMetrix[from * m_stride + to];
 }
 
 template<class T, class W>
 inline void WeightedDirectedMatrixGraph<T, W>::SetWeight(VertexPosType from, VertexPosType to, const W& weight)
 {
-	m_adjaMetrix[from][to] = weight;
+	m_adjaMetrix[from * m_stride + to] = weight;
 }
 
 template<class T, class W>
 inline void WeightedDirectedMatrixGraph<T, W>::RemoveVertex(VertexPosType v)
 {
-	for (VertexPosType i = 0; i < this->m_vertexData.size(); ++i)//减去相关边的数量
+	size_t vertexNum = this->GetVertexNum();
+	for (VertexPosType i = 0; i < vertexNum; ++i)//减去相关边的数量，出边和入边都会被删除
+	{
 		if (this->ExistEdge(v, i))
 			--this->m_edgeNum;
-	this->m_vertexData.erase(this->m_vertexData.begin() + v);
-	m_adjaMetrix.erase(m_adjaMetrix.begin() + v);
-	for (auto& i : m_adjaMetrix)
-		i.erase(i.begin() + v);
+		if (i != v && this->ExistEdge(i, v))
+			--this->m_edgeNum;
+	}
+	this->EraseVertexData(v);
+
+	//v之后的行整体上移一行
+	std::copy(m_adjaMetrix.begin() + (v + 1) * m_stride, m_adjaMetrix.end(), m_adjaMetrix.begin() + v * m_stride);
+	m_adjaMetrix.resize((vertexNum - 1) * m_stride);
+	//每行v之后的列左移一列，最后一列补0
+	for (VertexPosType i = 0; i + 1 < vertexNum; ++i)
+	{
+		auto row = m_adjaMetrix.begin() + i * m_stride;
+		std::copy(row + v + 1, row + vertexNum, row + v);
+		row[vertexNum - 1] = (W)0;
+	}
+}
+
+template<class T, class W>
+inline std::vector<typename WeightedDirectedMatrixGraph<T, W>::VertexPosType> WeightedDirectedMatrixGraph<T, W>::Compact()
+{
+	std::vector<VertexPosType> mapping = this->GetCompactMapping();
+	if (this->GetRemovedVertexNum() == 0)
+		return mapping;
+	//新位置总是不大于旧位置，按行优先顺序原地移动不会覆盖还没读取的数据
+	size_t vertexNum = this->GetVertexNum(), size = vertexNum - this->GetRemovedVertexNum();
+	for (VertexPosType i = 0; i < vertexNum; ++i)
+	{
+		if (mapping[i] == this->NPOS)
+			continue;
+		for (VertexPosType j = 0; j < vertexNum; ++j)
+			if (mapping[j] != this->NPOS)
+				m_adjaMetrix[mapping[i] * m_stride + mapping[j]] = m_adjaMetrix[i * m_stride + j];
+		std::fill(m_adjaMetrix.begin() + mapping[i] * m_stride + size, m_adjaMetrix.begin() + mapping[i] * m_stride + vertexNum, (W)0);
+	}
+	m_adjaMetrix.resize(size * m_stride);
+	this->CompactVertexData(mapping);
+	return mapping;
+}
+
+template<class T, class W>
+inline void WeightedDirectedMatrixGraph<T, W>::ForeachOutNeighbor(VertexPosType v, OnPassVertex func) const
+{
+	for (VertexPosType i = 0, base = v * m_stride; i < this->GetVertexNum(); ++i)
+		if (m_adjaMetrix[base + i] != (W)0)
+			func(i);
+}
+
+template<class T, class W>
+inline void WeightedDirectedMatrixGraph<T, W>::ForeachOutNeighbor(VertexPosType v, OnPassEdge func) const
+{
+	for (VertexPosType i = 0, base = v * m_stride; i < this->GetVertexNum(); ++i)
+		if (m_adjaMetrix[base + i] != (W)0)
+			func(v, i, m_adjaMetrix[base + i]);
 }
 
 template<class T, class W>
 inline void WeightedDirectedMatrixGraph<T, W>::ForeachEdge(OnPassEdge func) const
 {
 	for (VertexPosType i = 0; i < this->m_vertexData.size(); ++i)
-		for (VertexPosType j = 0; j < this->m_vertexData.size(); ++j)
-			if (this->ExistEdge(i, j))
-				func(i, j, GetWeight(i, j));
+		ForeachOutNeighbor(i, func);
 }
 
 template<class T, class W>
 inline std::vector<W> WeightedDirectedMatrixGraph<T, W>::GetAdjacencyMatrix() const
 {
-	//事实证明在图比较大的时候，遍历边是很慢的
+	size_t vertexNum = this->GetVertexNum();
+	if (vertexNum == m_stride)
+		return m_adjaMetrix;
 	std::vector<W> adja;
-	adja.reserve(this->GetVertexNum() * this->GetVertexNum());
-	for (auto& i : m_adjaMetrix)
-		adja.insert(adja.end(), i.begin(), i.end());
+	adja.reserve(vertexNum * vertexNum);
+	for (VertexPosType i = 0; i < vertexNum; ++i)
+		adja.insert(adja.end(), m_adjaMetrix.begin() + i * m_stride, m_adjaMetrix.begin() + i * m_stride + vertexNum);
 	return adja;
 }
 
 template<class T, class W>
 inline void WeightedDirectedMatrixGraph<T, W>::Shrink_To_Fit()
 {
+	if (m_stride != this->GetVertexNum())
+		Relayout(this->GetVertexNum());
 	m_adjaMetrix.shrink_to_fit();
-	for (auto& i : m_adjaMetrix)
-		i.shrink_to_fit();
 }
 
 template<class T, class W>
 inline unsigned long long WeightedDirectedMatrixGraph<T, W>::GetMemoryUsage() const
 {
-	return this->GetVertexNum() * ((unsigned long long)this->GetVertexNum() * sizeof(W) + sizeof(std::vector<W>)) + sizeof(m_adjaMetrix);
+	return (unsigned long long)m_adjaMetrix.capacity() * sizeof(W) + sizeof(m_adjaMetrix);
+}
+
+template<class T, class W>
+inline size_t WeightedDirectedMatrixGraph<T, W>::GetStride() const
+{
+	return m_stride;
+}
+
+template<class T, class W>
+inline const W* WeightedDirectedMatrixGraph<T, W>::GetRow(VertexPosType v) const
+{
+	return m_adjaMetrix.data() + v * m_stride;
+}
+
+template<class T, class W>
+inline const W* WeightedDirectedMatrixGraph<T, W>::GetRowData(VertexPosType v, size_t& len) const
+{
+	len = this->GetVertexNum();
+	return GetRow(v);
 }
 
 template<class T, class W>
@@ -127,3 +237,18 @@ inline constexpr bool WeightedDirectedMatrixGraph<T, W>::IsWeighted() const
 {
 	return true;
 }
+
+template<class T, class W>
+inline void WeightedDirectedMatrixGraph<T, W>::Relayout(size_t stride)
+{
+	size_t vertexNum = this->GetVertexNum();
+	std::vector<W> adja;
+	adja.reserve(vertexNum * stride);
+	for (VertexPosType i = 0; i < vertexNum; ++i)
+	{
+		adja.insert(adja.end(), m_adjaMetrix.begin() + i * m_stride, m_adjaMetrix.begin() + i * m_stride + vertexNum);
+		adja.resize((i + 1) * stride, (W)0);
+	}
+	m_adjaMetrix.swap(adja);
+	m_stride = stride;
+}
@@ -2,21 +2,25 @@
 
 #include "WeightedDirectedLinkGraph.h"
 
-template<class T, class W = int, class E = _DefaultWeightedEdgeType<W>>
-class WeightedUndirectedLinkGraph :public WeightedDirectedLinkGraph<T, W, E>
+template<class T, class W = int, class E = _DefaultWeightedEdgeType<W>, template<class> class A = _DefaultEdgeAllocator>
+class WeightedUndirectedLinkGraph :public WeightedDirectedLinkGraph<T, W, E, A>
 {
 public:
 
 	using typename GraphBase<T, W>::VertexType;
 	using typename GraphBase<T, W>::WeightType;
-	using typename UnweightedDirectedLinkGraph<T, E, W>::EdgeType;
+	using typename UnweightedDirectedLinkGraph<T, E, W, A>::EdgeType;
 	using typename GraphBase<T, W>::VertexPosType;
 	using typename GraphBase<T, W>::OnPassVertex;
 	using typename GraphBase<T, W>::OnPassEdge;
+	using typename GraphBase<T, W>::EdgeTuple;
 
 	/*插入或删除一条边 O(VertexEdgeNum)*/
 	virtual void InsertEdge(VertexPosType v1, VertexPosType v2, const W& weight = true) override;
 
+	/*删除顶点，删完后下标会改变 O(EdgeNum)*/
+	virtual void RemoveVertex(VertexPosType v) override;
+
 	/*删除边 O(VertexEdgeNum)*/
 	virtual void RemoveEdge(VertexPosType v1, VertexPosType v2) override;
 
@@ -37,48 +41,64 @@ public:
 	virtual unsigned long long GetMemoryUsage()const override;
 
 	virtual constexpr bool IsDirected()const override;
+
+protected:
+
+	/*批量插入边，每条边会插入两个方向的节点*/
+	virtual void BulkInsertEdges(std::vector<EdgeTuple>& edges)override;
 };
 
-template<class T, class W, class E>
-inline void WeightedUndirectedLinkGraph<T, W, E>::InsertEdge(VertexPosType v1, VertexPosType v2, const W& weight)
+template<class T, class W, class E, template<class> class A>
+inline void WeightedUndirectedLinkGraph<T, W, E, A>::InsertEdge(VertexPosType v1, VertexPosType v2, const W& weight)
 {
 	size_t prevEdgeNum = this->m_edgeNum;
-	WeightedDirectedLinkGraph<T, W, E>::InsertEdge(v1, v2, weight); //调用父类插入边v1->v2
+	WeightedDirectedLinkGraph<T, W, E, A>::InsertEdge(v1, v2, weight); //调用父类插入边v1->v2
 	if (prevEdgeNum == this->m_edgeNum || v1 == v2) //边的数量没改变，说明已经存在这条边了或者如果是环只用添加一条边即可
 		return;
-	WeightedDirectedLinkGraph<T, W, E>::InsertEdge(v2, v1, weight); //因为是无向图所以再插v2->v1
+	WeightedDirectedLinkGraph<T, W, E, A>::InsertEdge(v2, v1, weight); //因为是无向图所以再插v2->v1
 	//因为插入或者删除了两次，所以把边的数量修正一下
 	this->m_edgeNum += (this->m_edgeNum > prevEdgeNum ? -1 : 1);
 }
 
-template<class T, class W, class E>
-inline void WeightedUndirectedLinkGraph<T, W, E>::RemoveEdge(VertexPosType v1, VertexPosType v2)
+template<class T, class W, class E, template<class> class A>
+inline void WeightedUndirectedLinkGraph<T, W, E, A>::RemoveVertex(VertexPosType v)
+{
+	//v的每个邻接点(包括自环)恰好对应一条边，父类会把两个方向的节点各算一次
+	size_t edgeNum = this->m_edgeNum;
+	for (E* e = this->m_entry[v]; e != nullptr; e = e->next)
+		--edgeNum;
+	WeightedDirectedLinkGraph<T, W, E, A>::RemoveVertex(v);
+	this->m_edgeNum = edgeNum;
+}
+
+template<class T, class W, class E, template<class> class A>
+inline void WeightedUndirectedLinkGraph<T, W, E, A>::RemoveEdge(VertexPosType v1, VertexPosType v2)
 {
 	//和插入同理
 	size_t prevEdgeNum = this->m_edgeNum;
-	WeightedDirectedLinkGraph<T, W, E>::RemoveEdge(v1, v2); //调用父类删除边v1->v2
+	WeightedDirectedLinkGraph<T, W, E, A>::RemoveEdge(v1, v2); //调用父类删除边v1->v2
 	if (prevEdgeNum == this->m_edgeNum || v1 == v2) //边的数量没改变，说明不存在这条边或者是个环[同InsertEdge]
 		return;
-	WeightedDirectedLinkGraph<T, W, E>::RemoveEdge(v2, v1); //因为是无向图所以再删v2->v1
+	WeightedDirectedLinkGraph<T, W, E, A>::RemoveEdge(v2, v1); //因为是无向图所以再删v2->v1
 	//因为删除了两次，所以把边的数量修正一下
 	++this->m_edgeNum;
 }
 
-template<class T, class W, class E>
-inline void WeightedUndirectedLinkGraph<T, W, E>::ForeachInNeighbor(VertexPosType v, OnPassVertex func) const
+template<class T, class W, class E, template<class> class A>
+inline void WeightedUndirectedLinkGraph<T, W, E, A>::ForeachInNeighbor(VertexPosType v, OnPassVertex func) const
 {
 	//对于无向图，出入相同
-	UnweightedDirectedLinkGraph<T, E, W>::ForeachOutNeighbor(v, func);
+	UnweightedDirectedLinkGraph<T, E, W, A>::ForeachOutNeighbor(v, func);
 }
 
-template<class T, class W, class E>
-inline void WeightedUndirectedLinkGraph<T, W, E>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
+template<class T, class W, class E, template<class> class A>
+inline void WeightedUndirectedLinkGraph<T, W, E, A>::ForeachInNeighbor(VertexPosType v, OnPassEdge func) const
 {
-	WeightedDirectedLinkGraph<T, W, E>::ForeachOutNeighbor(v, func);
+	WeightedDirectedLinkGraph<T, W, E, A>::ForeachOutNeighbor(v, func);
 }
 
-template<class T, class W, class E>
-inline void WeightedUndirectedLinkGraph<T, W, E>::ForeachEdge(OnPassEdge func) const
+template<class T, class W, class E, template<class> class A>
+inline void WeightedUndirectedLinkGraph<T, W, E, A>::ForeachEdge(OnPassEdge func) const
 {
 	for (VertexPosType v1 = 0; v1 < this->m_entry.size(); ++v1)
 		for (E* e = this->m_entry[v1]; e != nullptr; e = e->next)
@@ -86,8 +106,8 @@ inline void WeightedUndirectedLinkGraph<T, W, E>::ForeachEdge(OnPassEdge func) c
 				func(v1, e->vertex, e->weight);
 }
 
-template<class T, class W, class E>
-inline std::vector<W> WeightedUndirectedLinkGraph<T, W, E>::GetAdjacencyMatrix() const
+template<class T, class W, class E, template<class> class A>
+inline std::vector<W> WeightedUndirectedLinkGraph<T, W, E, A>::GetAdjacencyMatrix() const
 {
 	std::vector<W> adjaMetrix(this->m_vertexData.size() * this->m_vertexData.size(), false);
 	ForeachEdge(
@@ -99,14 +119,30 @@ inline std::vector<W> WeightedUndirectedLinkGraph<T, W, E>::GetAdjacencyMatrix()
 	return adjaMetrix;
 }
 
-template<class T, class W, class E>
-inline unsigned long long WeightedUndirectedLinkGraph<T, W, E>::GetMemoryUsage() const
+template<class T, class W, class E, template<class> class A>
+inline unsigned long long WeightedUndirectedLinkGraph<T, W, E, A>::GetMemoryUsage() const
 {
-	return  (unsigned long long)this->m_entry.size() * sizeof(E*) + (unsigned long long)this->GetEdgeNum() * sizeof(E) * 2 + sizeof(this->m_entry);
+	return  (unsigned long long)this->m_entry.size() * sizeof(E*) + this->m_allocator.GetMemoryUsage(this->GetEdgeNum() * 2) + sizeof(this->m_entry) + this->GetInEdgeIndexMemoryUsage();
 }
 
-template<class T, class W, class E>
-inline constexpr bool WeightedUndirectedLinkGraph<T, W, E>::IsDirected() const
+template<class T, class W, class E, template<class> class A>
+inline constexpr bool WeightedUndirectedLinkGraph<T, W, E, A>::IsDirected() const
 {
 	return false;
 }
+
+template<class T, class W, class E, template<class> class A>
+inline void WeightedUndirectedLinkGraph<T, W, E, A>::BulkInsertEdges(std::vector<EdgeTuple>& edges)
+{
+	this->SortUniqueEdges(edges, false);
+	this->MirrorEdges(edges);
+	//两个方向的节点总是同时存在的，所以插入的节点数加上自环数再除以2就是插入的边数
+	size_t prevEdgeNum = this->m_edgeNum, loopNum = 0;
+	size_t nodeNum = this->AppendEdges(edges, [&](VertexPosType from, VertexPosType to, const W& w)
+		{
+			if (from == to)
+				++loopNum;
+			return this->CreateEdgeNode(from, to, w);
+		});
+	this->m_edgeNum = prevEdgeNum + (nodeNum + loopNum) / 2;
+}
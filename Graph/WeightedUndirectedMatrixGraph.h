@@ -17,6 +17,9 @@ public:
 	/*插入一个顶点 O(Pos)-O(Ele+Pos-)(可能会牵扯到vector重新申请内存) */
 	virtual VertexPosType InsertVertex(const T& v)override;
 
+	/*预留vertexNum个顶点的对角矩阵空间*/
+	virtual void Reserve(size_t vertexNum, size_t edgeNum)override;
+
 	/*获取从v1到v2的权重 O(1)*/
 	virtual W GetWeight(VertexPosType v1, VertexPosType v2)const override;
 
@@ -26,6 +29,9 @@ public:
 	/*删除顶点，删完后下标会改变 O(1)-O(Ele) (下标越大速度越快)*/
 	virtual void RemoveVertex(VertexPosType v)override;
 
+	/*真正删除所有被标记删除的顶点并重新编号，整个对角矩阵一次压缩完成 O(Ele)*/
+	virtual std::vector<VertexPosType> Compact()override;
+
 	/*遍历所有边 O(Ele)*/
 	virtual void ForeachEdge(OnPassEdge func)const override;
 
@@ -40,6 +46,12 @@ public:
 	/*实际占用要大于该数值，因为vector会预留空间，调用Shrink_To_Fit函数后可能更趋近于该数值*/
 	virtual unsigned long long GetMemoryUsage()const override;
 
+	/*v行在对角矩阵中连续存储的部分，即第0--v列，第j(j>v)列位于GetRow(j)[v]，插入顶点后可能失效 O(1)*/
+	const W* GetRow(VertexPosType v)const;
+
+	/*同@GetRow，len为v+1 O(1)*/
+	virtual const W* GetRowData(VertexPosType v, size_t& len)const override;
+
 	virtual constexpr bool IsDirected()const override;
 
 	virtual constexpr bool IsWeighted()const override;
@@ -51,6 +63,9 @@ protected:
 template<class T, class W>
 inline typename WeightedUndirectedMatrixGraph<T, W>::VertexPosType WeightedUndirectedMatrixGraph<T, W>::InsertVertex(const T& v)
 {
+	VertexPosType pos;
+	if (this->ReuseRemovedSlot(v, pos)) //被标记删除的顶点所在的行列都是0
+		return pos;
 	this->m_vertexData.push_back(v);
 	m_adjaMetrix.reserve(m_adjaMetrix.size() + this->m_vertexData.size());
 	for (VertexPosType i = 0; i < this->m_vertexData.size(); ++i)
@@ -58,6 +73,13 @@ inline typename WeightedUndirectedMatrixGraph<T, W>::VertexPosType WeightedUndir
 	return this->m_vertexData.size() - 1;
 }
 
+template<class T, class W>
+inline void WeightedUndirectedMatrixGraph<T, W>::Reserve(size_t vertexNum, size_t edgeNum)
+{
+	GraphBase<T, W>::Reserve(vertexNum, edgeNum);
+	m_adjaMetrix.reserve((vertexNum + 1) * vertexNum / 2);
+}
+
 template<class T, class W>
 inline W WeightedUndirectedMatrixGraph<T, W>::GetWeight(VertexPosType v1, VertexPosType v2)const
 {
@@ -76,7 +98,7 @@ inline void WeightedUndirectedMatrixGraph<T, W>::RemoveVertex(VertexPosType v)
 	for (VertexPosType i = 0; i < this->m_vertexData.size(); ++i)//减去相关边的数量
 		if (this->ExistEdge(v, i))
 			--this->m_edgeNum;
-	this->m_vertexData.erase(this->m_vertexData.begin() + v);
+	this->EraseVertexData(v);
 	/*将该顶点所在行列数据收缩*/
 	/*如删除v1
 	  1列 向上 + 3列 右下
@@ -108,6 +130,29 @@ inline void WeightedUndirectedMatrixGraph<T, W>::RemoveVertex(VertexPosType v)
 	m_adjaMetrix.resize((1 + this->m_vertexData.size()) * this->m_vertexData.size() / 2);
 }
 
+template<class T, class W>
+inline std::vector<typename WeightedUndirectedMatrixGraph<T, W>::VertexPosType> WeightedUndirectedMatrixGraph<T, W>::Compact()
+{
+	std::vector<VertexPosType> mapping = this->GetCompactMapping();
+	if (this->GetRemovedVertexNum() == 0)
+		return mapping;
+	//被标记删除的顶点所在的行列都是0，边数不变
+	//新位置总是不大于旧位置，按存储顺序原地移动不会覆盖还没读取的数据
+	size_t vertexNum = this->GetVertexNum(), size = vertexNum - this->GetRemovedVertexNum();
+	for (VertexPosType i = 0; i < vertexNum; ++i)
+	{
+		if (mapping[i] == this->NPOS)
+			continue;
+		size_t from = i * (i + 1) / 2, to = mapping[i] * (mapping[i] + 1) / 2;
+		for (VertexPosType j = 0; j <= i; ++j)
+			if (mapping[j] != this->NPOS)
+				m_adjaMetrix[to + mapping[j]] = m_adjaMetrix[from + j];
+	}
+	m_adjaMetrix.resize((size + 1) * size / 2);
+	this->CompactVertexData(mapping);
+	return mapping;
+}
+
 template<class T, class W>
 inline std::vector<W> WeightedUndirectedMatrixGraph<T, W>::GetAdjacencyMatrix() const
 {
@@ -142,6 +187,19 @@ inline unsigned long long WeightedUndirectedMatrixGraph<T, W>::GetMemoryUsage()
 	return (unsigned long long)m_adjaMetrix.size() * sizeof(W) + sizeof(m_adjaMetrix);
 }
 
+template<class T, class W>
+inline const W* WeightedUndirectedMatrixGraph<T, W>::GetRow(VertexPosType v) const
+{
+	return m_adjaMetrix.data() + v * (v + 1) / 2;
+}
+
+template<class T, class W>
+inline const W* WeightedUndirectedMatrixGraph<T, W>::GetRowData(VertexPosType v, size_t& len) const
+{
+	len = v + 1;
+	return GetRow(v);
+}
+
 template<class T, class W>
 inline constexpr bool WeightedUndirectedMatrixGraph<T, W>::IsDirected() const
 {